@@ -8,7 +8,9 @@
 userConfig = {
 	build = {
 		test 		= true,
-		examples 	= true
+		tools 		= true,
+		examples 	= true,
+		benchmarks 	= true
 	},
 
 	-- Dependencies configuration:
@@ -68,9 +68,19 @@ workspace "Rexrn"
 		include ("test/Premake5Build.lua")
 	end
 
+	-- Build tools?
+	if userConfig.build.tools then
+		include ("tools/Premake5Build.lua")
+	end
+
 	-- Build examples?
 	if userConfig.build.examples then
 		include ("example/Premake5Build.lua")
 	end
 
+	-- Build benchmarks?
+	if userConfig.build.benchmarks then
+		include ("benchmark/Premake5Build.lua")
+	end
+
 	
\ No newline at end of file
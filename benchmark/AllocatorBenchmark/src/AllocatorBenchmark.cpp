@@ -0,0 +1,101 @@
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+
+// Compares rendering with the default allocator against rendering where every request
+// (format variables + result) uses its own `std::pmr::monotonic_buffer_resource`.
+
+enum class Language {
+	Polish, English, Spanish,
+	MAX // used to automatically determine language count
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+constexpr std::size_t NumTemplates 	= 64;
+constexpr std::size_t NumRequests 	= 1'000'000;
+
+/// <summary>
+///		Fills builder with `NumTemplates` templates, each one having few tokens.
+/// </summary>
+template <typename Builder>
+void fillCatalog(Builder& builder_)
+{
+	builder_.setConstant("COLOR_RED", "{FF0000FF}");
+	for (std::size_t i = 0; i < NumTemplates; ++i)
+	{
+		builder_.setTemplate(i, {
+				"Czesc, $(COLOR_RED)$(PersonName)! Masz $(Count) nowych wiadomosci od $(Sender).",
+				"Hello, $(COLOR_RED)$(PersonName)! You have $(Count) new messages from $(Sender).",
+				"Hola, $(COLOR_RED)$(PersonName)! Tienes $(Count) mensajes nuevos de $(Sender)."
+			});
+	}
+}
+
+/// <summary>
+///		Runs `func_` `NumRequests` times and prints its average duration.
+/// </summary>
+template <typename Func>
+void measure(char const* name_, Func&& func_)
+{
+	std::size_t checksum = 0;
+
+	auto const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < NumRequests; ++i)
+		checksum += func_(i);
+	auto const end = std::chrono::steady_clock::now();
+
+	auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << name_ << ": " << (static_cast<double>(ns) / NumRequests) << " ns/request"
+		<< " (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+	using namespace rexrn;
+
+	// Default allocator:
+	{
+		loc::StringBuilder<NumSupportedLanguages> builder;
+		fillCatalog(builder);
+
+		measure("std::allocator", [&](std::size_t i_) {
+				auto const result = builder.build(
+						static_cast<std::uint16_t>(i_ % NumSupportedLanguages), i_ % NumTemplates,
+						{ { "PersonName", "PoetaKodu" }, { "Count", "12" }, { "Sender", "Administrator of the server" } }
+					);
+				return result.size();
+			});
+	}
+
+	// Catalog in its own arena, every request in a monotonic buffer on the stack:
+	{
+		std::pmr::unsynchronized_pool_resource catalogResource;
+
+		loc::pmr::StringBuilder<NumSupportedLanguages> builder(&catalogResource);
+		fillCatalog(builder);
+
+		using Builder = decltype(builder);
+
+		measure("monotonic_buffer_resource per request", [&](std::size_t i_) {
+				std::array<std::byte, 2048> buffer;
+				std::pmr::monotonic_buffer_resource requestArena(buffer.data(), buffer.size());
+
+				Builder::FormatVariables variables(&requestArena);
+				variables.emplace("PersonName", "PoetaKodu");
+				variables.emplace("Count", "12");
+				variables.emplace("Sender", "Administrator of the server");
+
+				auto const result = builder.build(
+						static_cast<std::uint16_t>(i_ % NumSupportedLanguages), i_ % NumTemplates,
+						variables, &requestArena
+					);
+				return result.size();
+			});
+	}
+}
@@ -0,0 +1,17 @@
+project "MemoryBenchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	location (path.join(repoRoot, "build/%{prj.name}/benchmarks"))
+	targetdir (path.join(repoRoot, "bin/%{cfg.platform}/%{cfg.buildcfg}/benchmarks"))
+
+	includedirs {
+		-- Rexrn::LocCpp
+		path.join(repoRoot, "include"),
+	}
+
+	files {
+		-- Current project:
+		"src/**.cpp"
+	}
@@ -0,0 +1,59 @@
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <cinttypes>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+// Prints memory usage report of a synthetic catalog. Meant to be run (and compared) after storage changes.
+
+enum class Language {
+	Polish, English, Spanish,
+	MAX // used to automatically determine language count
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+constexpr std::size_t NumTemplates = 10'000;
+
+/// <summary>
+///		Prints single row of the report.
+/// </summary>
+void printBlock(std::string const& name_, rexrn::loc::MemoryBlock const& block_)
+{
+	std::cout << name_ << ": "
+		<< block_.totalBytes() << " B total, "
+		<< block_.bytes << " B allocated, "
+		<< block_.wastedBytes << " B wasted, "
+		<< block_.numAllocations << " allocations, "
+		<< block_.overheadBytes << " B overhead" << std::endl;
+}
+
+int main()
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setConstant("COLOR_RED", "{FF0000FF}");
+
+	for (std::size_t i = 0; i < NumTemplates; ++i)
+	{
+		auto const number = std::to_string(i);
+
+		// Every third template is not translated to Spanish, every tenth has no tokens.
+		builder.setTemplateTranslation(i, Language::Polish, "Wiadomosc " + number + (i % 10 ? " dla $(COLOR_RED)$(PersonName) od $(Sender)" : ""));
+		builder.setTemplateTranslation(i, Language::English, "Message " + number + (i % 10 ? " for $(COLOR_RED)$(PersonName) from $(Sender)" : ""));
+		if (i % 3)
+			builder.setTemplateTranslation(i, Language::Spanish, "Mensaje " + number + (i % 10 ? " para $(COLOR_RED)$(PersonName) de $(Sender)" : ""));
+	}
+
+	auto const usage = builder.memoryUsage();
+
+	printBlock("Total", usage.total);
+	printBlock("Template table", usage.templateTable);
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		printBlock("Language " + std::to_string(lang), usage.languages[lang]);
+	printBlock("Template 1", usage.templates[1]);
+	printBlock("Token names", usage.tokenNames);
+	printBlock("Constants", usage.constants);
+	std::cout << "Duplicated strings: " << usage.numDuplicatedStrings << " (" << usage.duplicatedStringBytes << " B)" << std::endl;
+}
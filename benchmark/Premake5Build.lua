@@ -0,0 +1,6 @@
+group "Benchmarks"
+
+include("AllocatorBenchmark/Premake5Build.lua")
+include("RenderBenchmark/Premake5Build.lua")
+include("MemoryBenchmark/Premake5Build.lua")
+include("ReloadBenchmark/Premake5Build.lua")
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures the steps `CatalogLoader` performs to publish a hot reload of a single translation:
+// copying the current snapshot, applying the update and flattening template references again.
+
+enum class Language {
+	Polish, English, Spanish,
+	MAX // used to automatically determine language count
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+constexpr std::size_t NumTemplates 	= 20'000;
+constexpr std::size_t NumReloads 	= 50;
+
+using Builder = rexrn::loc::StringBuilder<NumSupportedLanguages>;
+
+/// <summary>
+///		Fills builder with `NumTemplates` templates, every fourth one referring to the previous one.
+/// </summary>
+void fillCatalog(Builder& builder_)
+{
+	builder_.setFallbackLanguage(Language::English);
+	for (std::size_t i = 0; i < NumTemplates; ++i)
+	{
+		std::string const suffix = (i % 4 == 3) ? " ($(@" + std::to_string(i - 1) + "))" : "";
+		builder_.setTemplate(i, {
+				"Czesc, $(PersonName)! Masz $(Count) nowych wiadomosci." + suffix,
+				"Hello, $(PersonName)! You have $(Count) new messages." + suffix,
+				"Hola, $(PersonName)! Tienes $(Count) mensajes nuevos." + suffix
+			});
+	}
+	builder_.freeze();
+}
+
+/// <summary>
+///		Runs `func_` `NumReloads` times and prints its average duration.
+/// </summary>
+template <typename Func>
+void measure(char const* name_, Func&& func_)
+{
+	std::size_t checksum = 0;
+
+	auto const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < NumReloads; ++i)
+		checksum += func_(i);
+	auto const end = std::chrono::steady_clock::now();
+
+	auto const us = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+	std::cout << name_ << ": " << (static_cast<double>(us) / NumReloads) << " us/reload"
+		<< " (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+	Builder catalog;
+	fillCatalog(catalog);
+
+	std::cout << "Catalog: " << NumTemplates << " templates, "
+		<< catalog.memoryUsage().total.bytes << " bytes (copied by every reload)" << std::endl;
+
+	// Changed translation is referenced by the next template:
+	auto const update = [](std::size_t i_) {
+			return std::vector<Builder::TranslationUpdate>{
+					{ (i_ * 4) % NumTemplates + 2, static_cast<std::uint16_t>(Language::Polish), "Zmieniono $(PersonName) #" + std::to_string(i_) }
+				};
+		};
+
+	measure("copy snapshot", [&](std::size_t) {
+			Builder next(catalog, catalog.getAllocator());
+			return next.getNumTemplates();
+		});
+
+	measure("copy + update + freeze (only referrers flattened)", [&](std::size_t i_) {
+			Builder next(catalog, catalog.getAllocator());
+			next.applyTranslationUpdates(update(i_));
+			next.freeze();
+			return next.getNumTemplates();
+		});
+
+	measure("copy + update + full freeze", [&](std::size_t i_) {
+			Builder next(catalog, catalog.getAllocator());
+			next.applyTranslationUpdates(update(i_));
+			next.setFallbackLanguage(Language::English); // Invalidates every flattened translation.
+			next.freeze();
+			return next.getNumTemplates();
+		});
+}
@@ -0,0 +1,87 @@
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <chrono>
+#include <cinttypes>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+// Compares rendering the same (language, template) pair repeatedly (e.g. every frame of a HUD)
+// through `build`, through a handle returned by `bind` and through `build` with a reused render context.
+
+enum class Language {
+	Polish, English, Spanish,
+	MAX // used to automatically determine language count
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+enum class LocTextIndex {
+	Score
+};
+
+constexpr std::size_t NumFrames = 1'000'000;
+
+/// <summary>
+///		Runs `func_` `NumFrames` times and prints its average duration.
+/// </summary>
+template <typename Func>
+void measure(char const* name_, Func&& func_)
+{
+	std::size_t checksum = 0;
+
+	auto const start = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < NumFrames; ++i)
+		checksum += func_(i);
+	auto const end = std::chrono::steady_clock::now();
+
+	auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << name_ << ": " << (static_cast<double>(ns) / NumFrames) << " ns/frame"
+		<< " (checksum " << checksum << ")" << std::endl;
+}
+
+int main()
+{
+	using namespace rexrn;
+	using Builder = loc::StringBuilder<NumSupportedLanguages>;
+
+	Builder builder;
+	builder.setFallbackLanguage(Language::English);
+	builder.setConstant("COLOR_RED", "{FF0000FF}");
+	// Spanish is not translated, fallback is used:
+	builder.setTemplateTranslation(LocTextIndex::Score, Language::Polish, "$(COLOR_RED)$(PlayerName): $(Score) pkt, $(Kills) zabojstw");
+	builder.setTemplateTranslation(LocTextIndex::Score, Language::English, "$(COLOR_RED)$(PlayerName): $(Score) pts, $(Kills) kills");
+
+	measure("build", [&](std::size_t i_) {
+			auto const score = std::to_string(i_);
+			return builder.build(Language::Spanish, LocTextIndex::Score,
+					{ { "PlayerName", "PoetaKodu" }, { "Score", score }, { "Kills", "12" } }
+				).size();
+		});
+
+	auto const handle = builder.bind(Language::Spanish, LocTextIndex::Score);
+
+	measure("bind + positional arguments", [&](std::size_t i_) {
+			auto const score = std::to_string(i_);
+			return handle({ "PoetaKodu", score, "12" }).size();
+		});
+
+	std::string frameBuffer;
+	measure("bind + positional arguments + reused buffer", [&](std::size_t i_) {
+			auto const score = std::to_string(i_);
+			std::string_view const arguments[] = { "PoetaKodu", score, "12" };
+
+			frameBuffer.clear();
+			handle.appendTo(frameBuffer, arguments, 3);
+			return frameBuffer.size();
+		});
+
+	auto& context = rexrn::loc::RenderContext<char>::threadLocal();
+	measure("build + thread-local render context", [&](std::size_t i_) {
+			context.reset()
+				.set("PlayerName", "PoetaKodu")
+				.set("Score", i_)
+				.set("Kills", 12);
+
+			return builder.build(context, Language::Spanish, LocTextIndex::Score).size();
+		});
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+#include <optional>
+#include <filesystem>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Single "key = value" entry read from a catalog file.
+/// </summary>
+/// <remarks>
+///		Catalog file format (one file per language):
+///		<code>
+///		# Comment
+///		0 = Hello, $(PersonName)!
+///		1 = Goodbye, $(PersonName)!
+///		</code>
+///		Whitespace around key and value is ignored. Value supports escape sequences:
+///		`\n` (new line), `\t` (tab), `\s` (space, e.g. to keep leading space) and `\\` (backslash).
+/// </remarks>
+template <typename CharType = char>
+struct CatalogEntry
+{
+	using StringType = std::basic_string<CharType>;
+
+	/// <summary>
+	///		The key (template index for translation files, constant name for constant files).
+	/// </summary>
+	StringType 	key;
+
+	/// <summary>
+	///		The value with escape sequences already resolved.
+	/// </summary>
+	StringType 	value;
+
+	/// <summary>
+	///		Line number (starting from 1) where the entry was defined.
+	/// </summary>
+	std::size_t line;
+};
+
+/// <summary>
+///		Result of catalog file parsing.
+/// </summary>
+template <typename CharType = char>
+struct CatalogParseResult
+{
+	/// <summary>
+	///		Entries in order of appearance.
+	/// </summary>
+	std::vector< CatalogEntry<CharType> > 	entries;
+
+	/// <summary>
+	///		Numbers (starting from 1) of lines that could not be parsed.
+	/// </summary>
+	std::vector<std::size_t> 				invalidLines;
+};
+
+/// <summary>
+///		Parses content of a catalog file.
+/// </summary>
+/// <param name="content_">Content of the file</param>
+/// <returns>Parsed entries and invalid lines.</returns>
+template <typename CharType>
+CatalogParseResult<CharType> parseCatalog(std::basic_string_view<CharType> content_);
+
+/// <summary>
+///		Converts catalog entry key to template index.
+/// </summary>
+/// <param name="key_">The key</param>
+/// <returns>Template index. Empty optional if key is not a decimal number.</returns>
+template <typename CharType>
+std::optional<std::size_t> parseTemplateIndex(std::basic_string_view<CharType> key_);
+
+/// <summary>
+///		Highest template index accepted from catalog files by default. Builders allocate every template slot up to
+/// 	the highest index, so a mistyped key (e.g. "99999999") must not be taken as a template index.
+/// </summary>
+constexpr std::size_t DefaultMaxTemplateIndex = 65'535;
+
+/// <summary>
+///		Collects translations from entries of a translation file.
+/// </summary>
+/// <param name="entries_">Parsed entries</param>
+/// <param name="ignored_">If not null, receives entries ignored because their key is not a template index</param>
+/// <param name="invalidLines_">If not null, receives lines of entries ignored because their template index exceeds `maxTemplateIndex_`</param>
+/// <param name="maxTemplateIndex_">Highest accepted template index</param>
+/// <returns>(template index, translation) pairs in order of appearance. Translations are views of `entries_`.</returns>
+template <typename CharType>
+std::vector< std::pair<std::size_t, std::basic_string_view<CharType>> > collectTranslations(
+	std::vector< CatalogEntry<CharType> > const& entries_, std::vector< CatalogEntry<CharType> const* >* ignored_ = nullptr,
+	std::vector<std::size_t>* invalidLines_ = nullptr, std::size_t maxTemplateIndex_ = DefaultMaxTemplateIndex);
+
+/// <summary>
+///		Reads entire file.
+/// </summary>
+/// <param name="path_">Path to the file</param>
+/// <returns>Content of the file. Empty optional if file could not be read.</returns>
+std::optional<std::string> readCatalogFile(std::filesystem::path const& path_);
+
+namespace detail
+{
+
+/// <summary>
+///		Instantiated by classes loading catalog files into builders: files are read as `char`.
+/// </summary>
+template <typename CharType>
+struct CatalogCharTypeCheck
+{
+	static_assert(std::is_same_v<CharType, char>, "Catalog files can only be loaded into `char` builders.");
+
+	static constexpr bool value = true;
+};
+
+}
+
+} // namespace rexrn::loc
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <Rexrn/LocCpp/CatalogFile.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <limits>
+
+namespace rexrn::loc
+{
+
+namespace detail
+{
+
+//////////////////////////////////////////////////////////////
+template <typename CharType>
+std::basic_string_view<CharType> trimCatalogWhitespace(std::basic_string_view<CharType> str_)
+{
+	auto const isSpace = [](CharType ch_) {
+			return ch_ == ' ' || ch_ == '\t' || ch_ == '\r';
+		};
+
+	while (!str_.empty() && isSpace(str_.front()))
+		str_.remove_prefix(1);
+	while (!str_.empty() && isSpace(str_.back()))
+		str_.remove_suffix(1);
+
+	return str_;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename CharType>
+std::basic_string<CharType> unescapeCatalogValue(std::basic_string_view<CharType> value_)
+{
+	std::basic_string<CharType> result;
+	result.reserve(value_.size());
+
+	for (std::size_t i = 0; i < value_.size(); ++i)
+	{
+		if (value_[i] != '\\' || i + 1 == value_.size())
+		{
+			result.push_back(value_[i]);
+			continue;
+		}
+
+		switch(value_[i + 1])
+		{
+		case 'n': 	result.push_back('\n'); break;
+		case 't': 	result.push_back('\t'); break;
+		case 's': 	result.push_back(' '); 	break;
+		case '\\': 	result.push_back('\\'); break;
+		default:
+			// Unknown sequence, keep it as is.
+			result.push_back(value_[i]);
+			result.push_back(value_[i + 1]);
+			break;
+		}
+		++i;
+	}
+
+	return result;
+}
+
+} // namespace detail
+
+//////////////////////////////////////////////////////////////
+template <typename CharType>
+CatalogParseResult<CharType> parseCatalog(std::basic_string_view<CharType> content_)
+{
+	CatalogParseResult<CharType> result;
+
+	std::size_t lineNumber = 0;
+	while (!content_.empty())
+	{
+		++lineNumber;
+
+		std::size_t const lineEnd = content_.find(CharType('\n'));
+		auto const line = detail::trimCatalogWhitespace(content_.substr(0, lineEnd));
+		content_.remove_prefix(lineEnd == content_.npos ? content_.size() : lineEnd + 1);
+
+		// Skip empty lines and comments:
+		if (line.empty() || line.front() == '#')
+			continue;
+
+		std::size_t const separator = line.find(CharType('='));
+		auto const key = detail::trimCatalogWhitespace(line.substr(0, separator));
+		if (separator == line.npos || key.empty())
+		{
+			result.invalidLines.push_back(lineNumber);
+			continue;
+		}
+
+		result.entries.push_back({
+				std::basic_string<CharType>(key),
+				detail::unescapeCatalogValue( detail::trimCatalogWhitespace(line.substr(separator + 1)) ),
+				lineNumber
+			});
+	}
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename CharType>
+std::optional<std::size_t> parseTemplateIndex(std::basic_string_view<CharType> key_)
+{
+	if (key_.empty())
+		return std::nullopt;
+
+	std::size_t index = 0;
+	for (CharType ch : key_)
+	{
+		if (ch < '0' || ch > '9')
+			return std::nullopt;
+
+		std::size_t const digit = static_cast<std::size_t>(ch - '0');
+		if (index > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+			return std::nullopt;
+
+		index = index * 10 + digit;
+	}
+
+	return index;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename CharType>
+std::vector< std::pair<std::size_t, std::basic_string_view<CharType>> > collectTranslations(
+	std::vector< CatalogEntry<CharType> > const& entries_, std::vector< CatalogEntry<CharType> const* >* ignored_,
+	std::vector<std::size_t>* invalidLines_, std::size_t maxTemplateIndex_)
+{
+	std::vector< std::pair<std::size_t, std::basic_string_view<CharType>> > translations;
+	translations.reserve(entries_.size());
+
+	for (auto const& entry : entries_)
+	{
+		auto const templateIndex = parseTemplateIndex<CharType>(entry.key);
+		if (!templateIndex.has_value())
+		{
+			if (ignored_)
+				ignored_->push_back(&entry);
+		}
+		else if (*templateIndex > maxTemplateIndex_)
+		{
+			if (invalidLines_)
+				invalidLines_->push_back(entry.line);
+		}
+		else
+			translations.emplace_back(*templateIndex, entry.value);
+	}
+
+	return translations;
+}
+
+//////////////////////////////////////////////////////////////
+inline std::optional<std::string> readCatalogFile(std::filesystem::path const& path_)
+{
+	std::ifstream file(path_, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+		return std::nullopt;
+
+	std::ostringstream content;
+	content << file.rdbuf();
+	if (file.bad())
+		return std::nullopt;
+
+	return std::move(content).str();
+}
+
+} // namespace rexrn::loc
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Rexrn/LocCpp/StringBuilder.hpp>
+#include <Rexrn/LocCpp/CatalogFile.hpp>
+
+#include <memory>
+#include <filesystem>
+#include <vector>
+#include <map>
+#include <string>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Loads catalog files into a string builder and reloads them when they change on disk.
+/// </summary>
+/// <remarks>
+///		The loader publishes immutable snapshots of the builder. A reload prepares only the (template, language)
+/// 	entries that differ from the loaded ones, applies them to a copy of the current snapshot as a single batch
+/// 	and then atomically replaces the snapshot. Renderers holding the previous snapshot never observe a partially
+/// 	updated catalog.
+///
+/// 	Cost of a reload: the copy of the snapshot is proportional to the size of the whole catalog (snapshots do not share
+/// 	storage), while parsing and flattening of template references is limited to the changed translations and translations
+/// 	referring to them. With a monotonic (arena) allocator every reload allocates a full catalog that is never reclaimed,
+/// 	so use a pool or the default allocator for catalogs that are reloaded often. See `benchmark/ReloadBenchmark`.
+///
+/// 	On Linux changes are detected with inotify, elsewhere by comparing file modification time.
+/// 	`catalog()` may be called from any thread, every other method must be called from a single (owner) thread.
+/// </remarks>
+template <typename Builder>
+class CatalogLoader
+{
+public:
+	using CharType 			= typename Builder::StringType::value_type;
+	using StringType 		= typename Builder::StringType;
+	using CatalogPtr 		= std::shared_ptr<Builder const>;
+
+	static_assert(detail::CatalogCharTypeCheck<CharType>::value);
+
+	/// <summary>
+	///		Creates loader with initial catalog (e.g. with constants and fallback language set up).
+	/// </summary>
+	/// <param name="initialCatalog_">The initial catalog</param>
+	/// <param name="maxTemplateIndex_">Highest template index accepted from files, entries above it are reported as invalid lines</param>
+	explicit CatalogLoader(Builder initialCatalog_ = Builder{}, std::size_t maxTemplateIndex_ = DefaultMaxTemplateIndex);
+
+	CatalogLoader(CatalogLoader const&) = delete;
+	CatalogLoader& operator=(CatalogLoader const&) = delete;
+
+	/// <summary>
+	///		Stops watching files.
+	/// </summary>
+	~CatalogLoader();
+
+	/// <summary>
+	///		Loads translations of specified language from a file and starts watching it.
+	/// </summary>
+	/// <param name="path_">Path to the catalog file</param>
+	/// <param name="lang_">The language of every translation inside the file</param>
+	/// <returns>
+	///		True if file was loaded. The file is watched either way, so it is loaded once it appears.
+	/// </returns>
+	/// <remarks>
+	///		Single template should be translated in only one file per language.
+	/// </remarks>
+	bool addFile(std::filesystem::path path_, std::uint16_t lang_);
+
+	/// <summary>
+	///		Checks watched files for changes and applies them.
+	/// </summary>
+	/// <returns>Number of (template, language) entries that were updated or removed.</returns>
+	std::size_t poll();
+
+	/// <param name="path_">Path to the catalog file (as passed to `addFile`)</param>
+	/// <returns>
+	///		Numbers (starting from 1) of lines ignored when the file was last loaded: lines that could not be parsed
+	/// 	and entries with template index above the limit.
+	/// </returns>
+	std::vector<std::size_t> getInvalidLines(std::filesystem::path const& path_) const;
+
+	/// <returns>
+	///		Current snapshot of the catalog. Safe to call from any thread.
+	/// </returns>
+	CatalogPtr catalog() const {
+		return std::atomic_load(&_catalog);
+	}
+
+private:
+	using TranslationUpdate = typename Builder::TranslationUpdate;
+
+	/// <summary>
+	///		Catalog file and translations loaded from it.
+	/// </summary>
+	struct WatchedFile
+	{
+		std::filesystem::path 					path;
+		std::uint16_t 							lang;
+
+		/// <summary>
+		///		Translation sources (template index, source) currently published. Used to compute the difference.
+		/// </summary>
+		std::map<std::size_t, std::string> 		entries;
+
+		/// <summary>
+		///		Lines ignored when the published entries were read.
+		/// </summary>
+		std::vector<std::size_t> 				invalidLines;
+
+		std::filesystem::file_time_type 		lastWriteTime;
+		bool 									dirty;
+
+		/// <summary>
+		///		Determines whether changes are reported by inotify (otherwise modification time is compared).
+		/// </summary>
+		bool 									notified;
+	};
+
+	/// <summary>
+	///		Marks files which changed since last check as dirty.
+	/// </summary>
+	void detectChanges();
+
+	/// <summary>
+	///		Content read from a file, stored in `WatchedFile` once the updates are published.
+	/// </summary>
+	struct ReadFile
+	{
+		std::map<std::size_t, std::string> 		entries;
+		std::vector<std::size_t> 				invalidLines;
+	};
+
+	/// <summary>
+	///		Reads file and appends the difference against loaded entries to `updates_`.
+	/// </summary>
+	/// <param name="file_">The file</param>
+	/// <param name="updates_">The updates</param>
+	/// <param name="read_">Content read from the file</param>
+	/// <returns>True if file could be read.</returns>
+	bool diffFile(WatchedFile const& file_, std::vector<TranslationUpdate>& updates_, ReadFile& read_);
+
+	/// <summary>
+	///		Stores content read from the file after the updates were published, so that the next difference is computed against it.
+	/// </summary>
+	/// <param name="file_">The file</param>
+	/// <param name="read_">Content read from the file</param>
+	static void markLoaded(WatchedFile& file_, ReadFile&& read_);
+
+	/// <summary>
+	///		Applies updates to a copy of the current catalog and publishes the copy.
+	/// </summary>
+	/// <remarks>
+	///		Copies the whole catalog, but flattens again only translations depending on the updated ones.
+	/// </remarks>
+	/// <param name="updates_">The updates</param>
+	void publish(std::vector<TranslationUpdate> const& updates_);
+
+	std::vector<WatchedFile> 	_files;
+	CatalogPtr 					_catalog;
+	std::size_t 				_maxTemplateIndex;
+
+#if defined(__linux__)
+	/// <summary>
+	///		Starts watching directory containing the file. Directory is watched instead of the file itself,
+	/// 	so that files replaced by rename (as most editors do) are detected too.
+	/// </summary>
+	/// <param name="directory_">The directory</param>
+	/// <returns>True if changes inside the directory will be reported.</returns>
+	bool watchDirectory(std::filesystem::path const& directory_);
+
+	/// <summary>
+	///		inotify instance, -1 if not available (modification time is compared then).
+	/// </summary>
+	int 									_inotifyFd = -1;
+
+	/// <summary>
+	///		Map (watch descriptor, directory).
+	/// </summary>
+	std::map<int, std::filesystem::path> 	_watchedDirectories;
+#endif
+};
+
+} // namespace rexrn::loc
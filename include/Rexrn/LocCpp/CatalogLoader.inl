@@ -0,0 +1,252 @@
+#pragma once
+
+#include <Rexrn/LocCpp/CatalogLoader.hpp>
+#include <Rexrn/LocCpp/CatalogFile.inl>
+
+#include <system_error>
+#include <algorithm>
+
+#if defined(__linux__)
+	#include <sys/inotify.h>
+	#include <unistd.h>
+#endif
+
+namespace rexrn::loc
+{
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+CatalogLoader<Builder>::CatalogLoader(Builder initialCatalog_, std::size_t maxTemplateIndex_)
+	: _catalog( std::make_shared<Builder const>(std::move(initialCatalog_)) ),
+	_maxTemplateIndex(maxTemplateIndex_)
+{
+#if defined(__linux__)
+	_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+CatalogLoader<Builder>::~CatalogLoader()
+{
+#if defined(__linux__)
+	if (_inotifyFd != -1)
+		close(_inotifyFd);
+#endif
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+bool CatalogLoader<Builder>::addFile(std::filesystem::path path_, std::uint16_t lang_)
+{
+	std::error_code ec;
+	path_ = std::filesystem::absolute(path_, ec).lexically_normal();
+
+	// Dirty until loaded entries are published, so that a failed load is retried by `poll()`.
+	auto& file = _files.emplace_back( WatchedFile{ std::move(path_), lang_, {}, {}, {}, true, false } );
+#if defined(__linux__)
+	file.notified = this->watchDirectory(file.path.parent_path());
+#endif
+	file.lastWriteTime = std::filesystem::last_write_time(file.path, ec);
+
+	std::vector<TranslationUpdate> updates;
+	ReadFile read;
+	bool const loaded = this->diffFile(file, updates, read);
+	this->publish(updates);
+
+	if (loaded)
+		markLoaded(file, std::move(read));
+
+	return loaded;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+std::size_t CatalogLoader<Builder>::poll()
+{
+	this->detectChanges();
+
+	// Every changed file goes into the same batch.
+	std::vector<TranslationUpdate> updates;
+	std::vector< std::pair<WatchedFile*, ReadFile> > readFiles;
+	for (auto& file : _files)
+	{
+		if (!file.dirty)
+			continue;
+
+		// File that cannot be read now (e.g. being replaced) will be reported again.
+		ReadFile read;
+		if (this->diffFile(file, updates, read))
+			readFiles.emplace_back(&file, std::move(read));
+	}
+
+	this->publish(updates);
+
+	// Files are marked as loaded only once the batch is published. If publishing throws,
+	// they stay dirty and the next poll computes the same difference again.
+	for (auto& [file, read] : readFiles)
+		markLoaded(*file, std::move(read));
+
+	return updates.size();
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+void CatalogLoader<Builder>::detectChanges()
+{
+#if defined(__linux__)
+	if (_inotifyFd != -1)
+	{
+		alignas(inotify_event) char buffer[4096];
+
+		for(;;)
+		{
+			auto const length = read(_inotifyFd, buffer, sizeof(buffer));
+			if (length <= 0)
+				break;
+
+			for (char const* ptr = buffer; ptr < buffer + length; )
+			{
+				auto const& event = *reinterpret_cast<inotify_event const*>(ptr);
+				ptr += sizeof(inotify_event) + event.len;
+
+				// Events were lost, check everything.
+				if (event.mask & IN_Q_OVERFLOW)
+				{
+					for (auto& file : _files)
+						file.dirty = true;
+					continue;
+				}
+
+				auto itDirectory = _watchedDirectories.find(event.wd);
+				if (itDirectory == _watchedDirectories.end() || event.len == 0)
+					continue;
+
+				std::filesystem::path const changedPath = itDirectory->second / event.name;
+				for (auto& file : _files)
+				{
+					if (file.path == changedPath)
+						file.dirty = true;
+				}
+			}
+		}
+	}
+#endif
+
+	for (auto& file : _files)
+	{
+		if (file.notified)
+			continue;
+
+		std::error_code ec;
+		auto const writeTime = std::filesystem::last_write_time(file.path, ec);
+		if (!ec && writeTime != file.lastWriteTime)
+		{
+			file.lastWriteTime 	= writeTime;
+			file.dirty 			= true;
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+bool CatalogLoader<Builder>::diffFile(WatchedFile const& file_, std::vector<TranslationUpdate>& updates_, ReadFile& read_)
+{
+	auto content = readCatalogFile(file_.path);
+	if (!content.has_value())
+		return false;
+
+	auto parsed = parseCatalog<char>(*content);
+
+	// Keys which are not template indices are ignored, too large indices are reported
+	// instead of allocating every template slot up to them.
+	std::vector<std::size_t> invalidLines = std::move(parsed.invalidLines);
+	std::map<std::size_t, std::string> entries;
+	for (auto const& [templateIndex, translation] : collectTranslations<char>(parsed.entries, nullptr, &invalidLines, _maxTemplateIndex))
+		entries.insert_or_assign(templateIndex, std::string(translation));
+	std::sort(invalidLines.begin(), invalidLines.end());
+
+	auto const allocator = _catalog->getAllocator();
+
+	// Added or changed translations:
+	for (auto const& [templateIndex, source] : entries)
+	{
+		auto itLoaded = file_.entries.find(templateIndex);
+		if (itLoaded == file_.entries.end() || itLoaded->second != source)
+			updates_.push_back({ templateIndex, file_.lang, StringType(source.data(), source.size(), allocator) });
+	}
+
+	// Removed translations:
+	for (auto const& [templateIndex, source] : file_.entries)
+	{
+		if (entries.find(templateIndex) == entries.end())
+			updates_.push_back({ templateIndex, file_.lang, std::nullopt });
+	}
+
+	read_.entries 		= std::move(entries);
+	read_.invalidLines 	= std::move(invalidLines);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+void CatalogLoader<Builder>::markLoaded(WatchedFile& file_, ReadFile&& read_)
+{
+	file_.entries 		= std::move(read_.entries);
+	file_.invalidLines 	= std::move(read_.invalidLines);
+	file_.dirty 		= false;
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+std::vector<std::size_t> CatalogLoader<Builder>::getInvalidLines(std::filesystem::path const& path_) const
+{
+	std::error_code ec;
+	auto const path = std::filesystem::absolute(path_, ec).lexically_normal();
+
+	for (auto const& file : _files)
+	{
+		if (file.path == path)
+			return file.invalidLines;
+	}
+
+	return {};
+}
+
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+void CatalogLoader<Builder>::publish(std::vector<TranslationUpdate> const& updates_)
+{
+	if (updates_.empty())
+		return;
+
+	// Copying a builder does not parse anything, only the updates are prepared.
+	auto next = std::make_shared<Builder>(*_catalog, _catalog->getAllocator());
+	next->applyTranslationUpdates(updates_);
+
+	// Changed translations may be referenced by other templates, so their referrers are flattened again
+	// before the snapshot becomes visible. Flattened translations copied from the current snapshot are kept.
+	next->freeze();
+
+	std::atomic_store(&_catalog, CatalogPtr(std::move(next)));
+}
+
+#if defined(__linux__)
+//////////////////////////////////////////////////////////////
+template <typename Builder>
+bool CatalogLoader<Builder>::watchDirectory(std::filesystem::path const& directory_)
+{
+	if (_inotifyFd == -1)
+		return false;
+
+	// Adding the same directory again returns the same watch descriptor.
+	int const wd = inotify_add_watch(_inotifyFd, directory_.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (wd == -1)
+		return false;
+
+	_watchedDirectories[wd] = directory_;
+	return true;
+}
+#endif
+
+} // namespace rexrn::loc
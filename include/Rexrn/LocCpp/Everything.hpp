@@ -1,4 +1,16 @@
 #pragma once
 
+#include <Rexrn/LocCpp/TranslationView.hpp>
+#include <Rexrn/LocCpp/MemoryUsage.hpp>
+#include <Rexrn/LocCpp/RenderContext.hpp>
 #include <Rexrn/LocCpp/StringBuilder.hpp>
-#include <Rexrn/LocCpp/StringBuilder.inl>
\ No newline at end of file
+#include <Rexrn/LocCpp/StringBuilder.inl>
+#include <Rexrn/LocCpp/StaticStringBuilder.hpp>
+#include <Rexrn/LocCpp/CatalogFile.hpp>
+#include <Rexrn/LocCpp/CatalogFile.inl>
+#include <Rexrn/LocCpp/CatalogLoader.hpp>
+#include <Rexrn/LocCpp/CatalogLoader.inl>
+#include <Rexrn/LocCpp/PagedStringBuilder.hpp>
+#include <Rexrn/LocCpp/PagedStringBuilder.inl>
+#include <Rexrn/LocCpp/StringBuilderOverlay.hpp>
+#include <Rexrn/LocCpp/StringBuilderOverlay.inl>
\ No newline at end of file
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Heap memory used by a part of a builder.
+/// </summary>
+struct MemoryBlock
+{
+	/// <summary>
+	///		Bytes requested from the allocator (including unused capacity and container nodes).
+	/// </summary>
+	std::size_t bytes 			= 0;
+
+	/// <summary>
+	///		Part of `bytes` that is reserved but unused (capacity greater than size).
+	/// </summary>
+	std::size_t wastedBytes 	= 0;
+
+	/// <summary>
+	///		Number of allocations.
+	/// </summary>
+	std::size_t numAllocations 	= 0;
+
+	/// <summary>
+	///		Estimated allocator bookkeeping (headers, alignment) of the allocations, not included in `bytes`.
+	/// </summary>
+	std::size_t overheadBytes 	= 0;
+
+	/// <returns>
+	///		Bytes taken from the system, including allocator overhead.
+	/// </returns>
+	std::size_t totalBytes() const {
+		return bytes + overheadBytes;
+	}
+
+	MemoryBlock& operator+=(MemoryBlock const& other_)
+	{
+		bytes 			+= other_.bytes;
+		wastedBytes 	+= other_.wastedBytes;
+		numAllocations 	+= other_.numAllocations;
+		overheadBytes 	+= other_.overheadBytes;
+		return *this;
+	}
+};
+
+/// <summary>
+///		Memory usage report of a `StringBuilder`.
+/// </summary>
+/// <remarks>
+///		`total` is the sum of `templateTable`, `languages`, `tokenNames` and `constants`.
+/// 	`templates` is another breakdown of `languages` (the same bytes, grouped by template).
+/// 	The builder object itself (`sizeof`) is not included.
+/// </remarks>
+template <std::uint16_t NumSupportedLanguages>
+struct MemoryUsage
+{
+	/// <summary>
+	///		Everything below.
+	/// </summary>
+	MemoryBlock 									total;
+
+	/// <summary>
+	///		Buffer of the template vector (fixed-size per template part, allocated for every index up to the highest one).
+	/// </summary>
+	MemoryBlock 									templateTable;
+
+	/// <summary>
+	///		Base format strings, format points and flattened translations, per language.
+	/// </summary>
+	std::array<MemoryBlock, NumSupportedLanguages> 	languages;
+
+	/// <summary>
+	///		Base format strings, format points and flattened translations, per template.
+	/// </summary>
+	std::vector<MemoryBlock> 						templates;
+
+	/// <summary>
+	///		Stored token names (set nodes and their strings).
+	/// </summary>
+	MemoryBlock 									tokenNames;
+
+	/// <summary>
+	///		Constants (map nodes and their values).
+	/// </summary>
+	MemoryBlock 									constants;
+
+	/// <summary>
+	///		Number of non-empty format strings with the same content as another one (e.g. untranslated copies).
+	/// </summary>
+	std::size_t 									numDuplicatedStrings 	= 0;
+
+	/// <summary>
+	///		Characters' bytes of the duplicated strings (every copy except the first one).
+	/// </summary>
+	std::size_t 									duplicatedStringBytes 	= 0;
+};
+
+namespace detail
+{
+
+/// <summary>
+///		Estimated size of links stored in every node of `std::set` / `std::map` (parent, left, right, color).
+/// </summary>
+constexpr std::size_t TreeNodeLinksSize = 4 * sizeof(void*);
+
+/// <summary>
+///		Accounts heap memory of a string. Strings short enough for small string optimization are not allocated.
+/// </summary>
+template <typename StringType>
+void accountString(MemoryBlock& block_, StringType const& str_, std::size_t allocationOverhead_)
+{
+	auto const* const object 	= reinterpret_cast<char const*>(&str_);
+	auto const* const data 		= reinterpret_cast<char const*>(str_.data());
+	if (data >= object && data < object + sizeof(StringType))
+		return;
+
+	using CharType = typename StringType::value_type;
+	block_.bytes 			+= (str_.capacity() + 1) * sizeof(CharType);
+	block_.wastedBytes 		+= (str_.capacity() - str_.size()) * sizeof(CharType);
+	block_.numAllocations 	+= 1;
+	block_.overheadBytes 	+= allocationOverhead_;
+}
+
+/// <summary>
+///		Accounts heap memory of a vector buffer (not of its elements' own allocations).
+/// </summary>
+template <typename VectorType>
+void accountVector(MemoryBlock& block_, VectorType const& vector_, std::size_t allocationOverhead_)
+{
+	if (vector_.capacity() == 0)
+		return;
+
+	using ValueType = typename VectorType::value_type;
+	block_.bytes 			+= vector_.capacity() * sizeof(ValueType);
+	block_.wastedBytes 		+= (vector_.capacity() - vector_.size()) * sizeof(ValueType);
+	block_.numAllocations 	+= 1;
+	block_.overheadBytes 	+= allocationOverhead_;
+}
+
+/// <summary>
+///		Accounts single node of `std::set` / `std::map` (not of its value's own allocations).
+/// </summary>
+template <typename ValueType>
+void accountTreeNode(MemoryBlock& block_, std::size_t allocationOverhead_)
+{
+	block_.bytes 			+= sizeof(ValueType) + TreeNodeLinksSize;
+	block_.numAllocations 	+= 1;
+	block_.overheadBytes 	+= allocationOverhead_;
+}
+
+} // namespace detail
+
+} // namespace rexrn::loc
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <Rexrn/LocCpp/StringBuilder.hpp>
+
+#include <array>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		String builder that loads translations of a language only when they are first needed
+/// 	and unloads least recently used languages to stay within a memory budget.
+/// </summary>
+/// <remarks>
+///		Translations of a language (a "page") are requested from the catalog source the first time `build` asks for
+/// 	that language. Once resident, rendering goes straight to the underlying `StringBuilder`. After a page is loaded,
+/// 	least recently used languages are unloaded until resident translations fit in the budget. The fallback language
+/// 	is loaded up front and never unloaded, so every missing translation can still fall back to it.
+///
+/// 	Budget is soft: the language being rendered is never unloaded, even if it alone exceeds the budget.
+///
+/// 	<b>Not thread-safe.</b> Every `build` (even of a resident language) updates the usage stamp and may load or unload
+/// 	languages, i.e. modify the underlying builder. No member function, including the const ones and `getBuilder()`,
+/// 	may be called while another thread calls any other member function. Guard the whole object with a mutex or keep
+/// 	one instance per thread. This differs from `StringBuilder::build`, which is safe to call concurrently.
+/// </remarks>
+template <std::uint16_t NumSupportedLanguages, typename CharType = char, typename Allocator = std::allocator<CharType>>
+class PagedStringBuilder
+{
+public:
+	using BuilderType 		= StringBuilder<NumSupportedLanguages, CharType, Allocator>;
+	using StringType 		= typename BuilderType::StringType;
+	using StringViewType 	= typename BuilderType::StringViewType;
+	using FormatVariables 	= typename BuilderType::FormatVariables;
+
+	/// <summary>
+	///		Translations of a single language: (template index, translation) pairs.
+	/// </summary>
+	using CatalogPage 		= std::vector< std::pair<std::size_t, StringType> >;
+
+	/// <summary>
+	///		Returns translations of specified language. Empty optional if they could not be loaded.
+	/// </summary>
+	using CatalogSource 	= std::function< std::optional<CatalogPage> (std::uint16_t lang_) >;
+
+	/// <summary>
+	///		Creates paged builder and loads the fallback language.
+	/// </summary>
+	/// <param name="source_">Source of the translations</param>
+	/// <param name="memoryBudget_">Bytes that translations of resident languages may take (see `StringBuilder::memoryUsage`)</param>
+	/// <param name="base_">
+	///		Builder with constants and fallback language set up. Its translations are discarded, they are loaded from the source.
+	/// </param>
+	PagedStringBuilder(CatalogSource source_, std::size_t memoryBudget_, BuilderType base_ = BuilderType{});
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	///		Loads the language first if it is not resident.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType operator()(LanguageType lang_, IndexType templateIndex_, FormatVariables formatVariables_ = {})
+	{
+		return this->build(lang_, templateIndex_, std::move(formatVariables_));
+	}
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	///		Loads the language first if it is not resident.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	/// <remarks>
+	///		Modifies the paged builder, must not be called concurrently (see class remarks).
+	/// </remarks>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType build(LanguageType lang_, IndexType templateIndex_, FormatVariables formatVariables_ = {})
+	{
+		auto const lang = static_cast<std::uint16_t>(lang_);
+		if (lang < NumSupportedLanguages)
+			this->touch(lang);
+
+		return _builder.build(lang, static_cast<std::size_t>(templateIndex_), std::move(formatVariables_));
+	}
+
+	/// <summary>
+	///		Loads specified language (if not resident yet) and marks it as most recently used.
+	/// </summary>
+	/// <param name="lang_">The language</param>
+	/// <returns>True if translations could be loaded from the source.</returns>
+	bool load(std::uint16_t lang_);
+
+	/// <summary>
+	///		Unloads translations of specified language. The fallback language cannot be unloaded.
+	/// </summary>
+	/// <param name="lang_">The language</param>
+	/// <remarks>
+	///		Language is loaded from the source again the next time it is used. This also retries languages which failed to load.
+	/// </remarks>
+	void unload(std::uint16_t lang_);
+
+	/// <summary>
+	///		Changes memory budget, unloading languages that no longer fit.
+	/// </summary>
+	/// <param name="memoryBudget_">Bytes that translations of resident languages may take</param>
+	void setMemoryBudget(std::size_t memoryBudget_);
+
+	/// <returns>
+	///		Bytes that translations of resident languages may take.
+	/// </returns>
+	std::size_t getMemoryBudget() const {
+		return _memoryBudget;
+	}
+
+	/// <returns>
+	///		Bytes taken by translations of resident languages (measured when languages were loaded).
+	/// </returns>
+	std::size_t getResidentBytes() const;
+
+	/// <returns>
+	///		True if translations of specified language are loaded.
+	/// </returns>
+	bool isResident(std::uint16_t lang_) const {
+		return lang_ < NumSupportedLanguages && _pages[lang_].resident;
+	}
+
+	/// <returns>
+	///		The underlying builder, containing translations of resident languages only.
+	/// </returns>
+	BuilderType const& getBuilder() const {
+		return _builder;
+	}
+
+	/// <summary>
+	///		Creates catalog source reading catalog files (see `parseCatalog`), one file per language.
+	/// </summary>
+	/// <param name="paths_">Path of the catalog file of every language, in language order. Empty path: no translations.</param>
+	/// <returns>The source.</returns>
+	static CatalogSource catalogFiles(std::vector<std::filesystem::path> paths_);
+
+private:
+	/// <summary>
+	///		Residency of a language.
+	/// </summary>
+	struct LanguagePage
+	{
+		bool 			resident 	= false;
+
+		/// <summary>
+		///		Determines whether the source failed to provide translations (language is resident anyway and falls back).
+		/// </summary>
+		bool 			failed 		= false;
+
+		/// <summary>
+		///		Value of the use counter when the language was last used.
+		/// </summary>
+		std::uint64_t 	lastUse 	= 0;
+
+		/// <summary>
+		///		Bytes taken by translations of the language.
+		/// </summary>
+		std::size_t 	bytes 		= 0;
+	};
+
+	/// <summary>
+	///		Marks language as most recently used, loading it if needed.
+	/// </summary>
+	void touch(std::uint16_t lang_)
+	{
+		auto& page = _pages[lang_];
+		if (!page.resident)
+			this->pageIn(lang_);
+
+		page.lastUse = ++_useCounter;
+	}
+
+	/// <summary>
+	///		Loads translations of the language from the source and unloads languages exceeding the budget.
+	/// </summary>
+	/// <returns>True if translations could be loaded from the source.</returns>
+	bool pageIn(std::uint16_t lang_);
+
+	/// <summary>
+	///		Unloads least recently used languages until resident translations fit in the budget.
+	/// </summary>
+	/// <param name="keep_">Language that must stay resident (the one being used)</param>
+	void evictToBudget(std::uint16_t keep_);
+
+	/// <summary>
+	///		Flattens references of the loaded language and updates its size.
+	/// </summary>
+	/// <param name="lang_">The loaded language</param>
+	/// <remarks>
+	///		References resolve within the same language or the fallback language, so loading a language changes
+	/// 	translations of other languages only if it is the fallback language. Unloading needs no refreeze at all.
+	/// </remarks>
+	void refreeze(std::uint16_t lang_);
+
+	/// <returns>
+	///		True if specified language must stay resident.
+	/// </returns>
+	bool isPinned(std::uint16_t lang_) const {
+		return lang_ == _builder.getFallbackLanguage();
+	}
+
+	CatalogSource 										_source;
+	std::size_t 										_memoryBudget;
+	BuilderType 										_builder;
+	std::array<LanguagePage, NumSupportedLanguages> 	_pages;
+	std::uint64_t 										_useCounter = 0;
+};
+
+} // namespace rexrn::loc
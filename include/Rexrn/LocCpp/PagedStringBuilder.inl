@@ -0,0 +1,179 @@
+#pragma once
+
+#include <Rexrn/LocCpp/PagedStringBuilder.hpp>
+#include <Rexrn/LocCpp/StringBuilder.inl>
+#include <Rexrn/LocCpp/CatalogFile.inl>
+
+namespace rexrn::loc
+{
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::PagedStringBuilder(CatalogSource source_, std::size_t memoryBudget_, BuilderType base_)
+	: _source(std::move(source_)),
+	_memoryBudget(memoryBudget_),
+	_builder(std::move(base_))
+{
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		_builder.removeTranslation(lang);
+
+	auto const fallback = _builder.getFallbackLanguage();
+	if (fallback < NumSupportedLanguages)
+		this->pageIn(fallback);
+	else
+		_builder.freeze();
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::load(std::uint16_t lang_)
+{
+	if (lang_ >= NumSupportedLanguages)
+		return false;
+
+	if (!_pages[lang_].resident)
+		this->pageIn(lang_);
+
+	_pages[lang_].lastUse = ++_useCounter;
+	return !_pages[lang_].failed;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::unload(std::uint16_t lang_)
+{
+	if (lang_ >= NumSupportedLanguages || this->isPinned(lang_))
+		return;
+
+	auto& page = _pages[lang_];
+	if (!page.resident)
+		return;
+
+	// Translations of other languages stay flattened.
+	_builder.removeTranslation(lang_);
+	page = LanguagePage{};
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::setMemoryBudget(std::size_t memoryBudget_)
+{
+	_memoryBudget = memoryBudget_;
+
+	// Most recently used language is kept, just like the one being loaded in `pageIn`.
+	std::uint16_t mostRecent = NumSupportedLanguages;
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		if (_pages[lang].resident && (mostRecent == NumSupportedLanguages || _pages[lang].lastUse > _pages[mostRecent].lastUse))
+			mostRecent = lang;
+	}
+
+	this->evictToBudget(mostRecent);
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+std::size_t PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::getResidentBytes() const
+{
+	std::size_t bytes = 0;
+	for (auto const& page : _pages)
+		bytes += page.bytes;
+
+	return bytes;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::pageIn(std::uint16_t lang_)
+{
+	auto page = _source ? _source(lang_) : std::nullopt;
+
+	if (page.has_value())
+	{
+		std::vector<typename BuilderType::TranslationUpdate> updates;
+		updates.reserve(page->size());
+		for (auto& [templateIndex, translation] : *page)
+			updates.push_back({ templateIndex, lang_, std::move(translation) });
+
+		_builder.applyTranslationUpdates(updates);
+	}
+
+	// Language that failed to load is resident too (renders fall back), so that the source is not asked on every render.
+	_pages[lang_].resident = true;
+	_pages[lang_].failed = !page.has_value();
+	_pages[lang_].lastUse = ++_useCounter;
+
+	this->refreeze(lang_);
+	this->evictToBudget(lang_);
+
+	return page.has_value();
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::evictToBudget(std::uint16_t keep_)
+{
+	while (this->getResidentBytes() > _memoryBudget)
+	{
+		std::uint16_t victim = NumSupportedLanguages;
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			auto const& page = _pages[lang];
+			if (!page.resident || lang == keep_ || this->isPinned(lang))
+				continue;
+
+			if (victim == NumSupportedLanguages || page.lastUse < _pages[victim].lastUse)
+				victim = lang;
+		}
+
+		if (victim == NumSupportedLanguages)
+			break;
+
+		// Translations of other languages stay flattened.
+		_builder.removeTranslation(victim);
+		_pages[victim] = LanguagePage{};
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::refreeze(std::uint16_t lang_)
+{
+	// Only translations depending on the loaded ones are flattened again.
+	_builder.freeze();
+
+	bool const fallback = this->isPinned(lang_);
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		if (lang == lang_ || fallback)
+			_pages[lang].bytes = _pages[lang].resident ? _builder.languageMemoryUsage(lang).totalBytes() : 0;
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::CatalogSource
+	PagedStringBuilder<NumSupportedLanguages, CharType, Allocator>::catalogFiles(std::vector<std::filesystem::path> paths_)
+{
+	static_assert(detail::CatalogCharTypeCheck<CharType>::value);
+
+	return [paths = std::move(paths_)](std::uint16_t lang_) -> std::optional<CatalogPage>
+		{
+			CatalogPage page;
+			if (lang_ >= paths.size() || paths[lang_].empty())
+				return page;
+
+			auto content = readCatalogFile(paths[lang_]);
+			if (!content.has_value())
+				return std::nullopt;
+
+			// Keys which are not template indices (or exceed `DefaultMaxTemplateIndex`) are ignored.
+			auto const entries = parseCatalog<char>(*content).entries;
+			for (auto const& [templateIndex, translation] : collectTranslations(entries))
+				page.emplace_back( templateIndex, StringType(translation.data(), translation.size()) );
+
+			return page;
+		};
+}
+
+} // namespace rexrn::loc
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+namespace rexrn::loc
+{
+
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+class StringBuilder;
+
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+class StaticStringBuilder;
+
+namespace detail
+{
+
+/// <summary>
+///		Determines whether type is a character type, i.e. an integral type which does not hold a number.
+/// </summary>
+template <typename T>
+constexpr bool isCharacter = std::is_same_v<T, char> || std::is_same_v<T, wchar_t>
+#ifdef __cpp_char8_t
+	|| std::is_same_v<T, char8_t>
+#endif
+	|| std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+}
+
+/// <summary>
+///		Reusable state of rendering: variable values, output buffer and scratch space.
+/// </summary>
+/// <remarks>
+///		Every buffer keeps its capacity between renders, so once the context has seen the longest variables and results,
+/// 	rendering through `build(context, ...)` of `StringBuilder` or `StaticStringBuilder` does not allocate at all.
+/// 	Keep one context per thread (see `threadLocal()`); the context must not be used by two threads at once.
+///
+/// 	Every buffer uses (a rebound copy of) `Allocator`, which must match the allocator of the builder.
+/// </remarks>
+template <typename CharType = char, typename Allocator = std::allocator<CharType>>
+class RenderContext
+{
+	/// <summary>
+	///		Allocator type rebound to the `T` value type.
+	/// </summary>
+	template <typename T>
+	using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+public:
+	using StringType 		= std::basic_string<CharType, std::char_traits<CharType>, Allocator>;
+	using StringViewType 	= std::basic_string_view<CharType>;
+
+	/// <summary>
+	///		Table (token name, value) of variables. Cleared without releasing memory.
+	/// </summary>
+	/// <remarks>
+	///		Lookup is linear, which is faster than a tree for the few variables a single render uses.
+	/// 	Provides the subset of map interface used by `renderTranslation`.
+	/// </remarks>
+	class VariableTable
+	{
+	public:
+		using value_type 		= std::pair<StringType, StringType>;
+		using const_iterator 	= typename std::vector< value_type, RebindAllocator<value_type> >::const_iterator;
+
+		/// <summary>
+		///		Creates empty table using specified allocator.
+		/// </summary>
+		/// <param name="allocator_">The allocator</param>
+		explicit VariableTable(Allocator const& allocator_)
+			: _entries(allocator_)
+		{
+		}
+
+		/// <summary>
+		///		Sets value of a variable, replacing previous value.
+		/// </summary>
+		/// <param name="name_">Token name</param>
+		/// <param name="value_">The value</param>
+		void set(StringViewType name_, StringViewType value_)
+		{
+			for (std::size_t i = 0; i < _size; ++i)
+			{
+				if (_entries[i].first == name_)
+				{
+					_entries[i].second.assign(value_);
+					return;
+				}
+			}
+
+			// Entries past the size are kept for reuse, together with their buffers.
+			if (_size == _entries.size())
+			{
+				Allocator const allocator(_entries.get_allocator());
+				_entries.emplace_back(StringType(allocator), StringType(allocator));
+			}
+
+			_entries[_size].first.assign(name_);
+			_entries[_size].second.assign(value_);
+			++_size;
+		}
+
+		/// <param name="name_">Token name</param>
+		/// <returns>
+		///		Iterator to the variable, `end()` if variable is not set.
+		/// </returns>
+		const_iterator find(StringViewType name_) const
+		{
+			for (auto it = this->begin(); it != this->end(); ++it)
+			{
+				if (it->first == name_)
+					return it;
+			}
+			return this->end();
+		}
+
+		const_iterator begin() const {
+			return _entries.begin();
+		}
+
+		const_iterator end() const {
+			return _entries.begin() + static_cast<std::ptrdiff_t>(_size);
+		}
+
+		std::size_t size() const {
+			return _size;
+		}
+
+		bool empty() const {
+			return _size == 0;
+		}
+
+		/// <summary>
+		///		Removes every variable (memory is kept for reuse).
+		/// </summary>
+		void clear() {
+			_size = 0;
+		}
+
+	private:
+		std::vector< value_type, RebindAllocator<value_type> > 	_entries;
+		std::size_t 											_size = 0;
+	};
+
+	/// <summary>
+	///		Creates empty context using default-constructed allocator.
+	/// </summary>
+	RenderContext()
+		: RenderContext( Allocator{} )
+	{
+	}
+
+	/// <summary>
+	///		Creates empty context using specified allocator for every buffer.
+	/// </summary>
+	/// <param name="allocator_">The allocator</param>
+	explicit RenderContext(Allocator const& allocator_)
+		: _variables(allocator_),
+		_output(allocator_),
+		_referenceStack(allocator_)
+	{
+	}
+
+	/// <summary>
+	///		Removes variables set for the previous render. Memory is kept for reuse.
+	/// </summary>
+	/// <returns>The context.</returns>
+	RenderContext& reset()
+	{
+		_variables.clear();
+		return *this;
+	}
+
+	/// <summary>
+	///		Sets value of a variable used by the next render.
+	/// </summary>
+	/// <param name="name_">Token name</param>
+	/// <param name="value_">The value</param>
+	/// <returns>The context.</returns>
+	RenderContext& set(StringViewType name_, StringViewType value_)
+	{
+		_variables.set(name_, value_);
+		return *this;
+	}
+
+	/// <summary>
+	///		Sets value of a variable used by the next render to decimal representation of a number (without allocating).
+	/// </summary>
+	/// <param name="name_">Token name</param>
+	/// <param name="value_">The value (integer, not `bool` nor character)</param>
+	/// <returns>The context.</returns>
+	template <typename IntegerType,
+		typename = std::enable_if_t< std::is_integral_v<IntegerType> && !std::is_same_v<IntegerType, bool> && !detail::isCharacter<IntegerType> > >
+	RenderContext& set(StringViewType name_, IntegerType value_)
+	{
+		// Enough for 64-bit integers with sign.
+		CharType digits[24];
+		CharType* const end = digits + sizeof(digits) / sizeof(CharType);
+		CharType* begin = end;
+
+		bool const negative = (value_ < 0);
+		auto magnitude = static_cast<std::make_unsigned_t<IntegerType>>(value_);
+		if (negative)
+			magnitude = static_cast<decltype(magnitude)>(0 - magnitude);
+
+		do
+		{
+			*--begin = static_cast<CharType>('0' + magnitude % 10);
+			magnitude /= 10;
+		} while (magnitude != 0);
+
+		if (negative)
+			*--begin = static_cast<CharType>('-');
+
+		return this->set(name_, StringViewType(begin, static_cast<std::size_t>(end - begin)));
+	}
+
+	/// <returns>
+	///		Variables used by the next render.
+	/// </returns>
+	VariableTable const& getVariables() const {
+		return _variables;
+	}
+
+	/// <returns>
+	///		Result of the last render. Valid until the next render with this context.
+	/// </returns>
+	StringViewType getOutput() const {
+		return _output;
+	}
+
+	/// <returns>
+	///		Context of the calling thread.
+	/// </returns>
+	static RenderContext& threadLocal()
+	{
+		static thread_local RenderContext context;
+		return context;
+	}
+
+private:
+	template <std::uint16_t, typename, typename>
+	friend class StringBuilder;
+
+	template <std::uint16_t, typename, typename>
+	friend class StaticStringBuilder;
+
+	VariableTable 									_variables;
+
+	/// <summary>
+	///		Output buffer, cleared (not released) before every render.
+	/// </summary>
+	StringType 										_output;
+
+	/// <summary>
+	///		Scratch space: (template index, language) pairs being rendered, used by templates with references.
+	/// </summary>
+	std::vector< std::pair<std::size_t, std::uint16_t>, RebindAllocator< std::pair<std::size_t, std::uint16_t> > > 	_referenceStack;
+};
+
+} // namespace rexrn::loc
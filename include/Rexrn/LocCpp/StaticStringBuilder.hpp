@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Rexrn/LocCpp/StringBuilder.hpp>
+
+#include <string>
+#include <string_view>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <cstdint>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Read-only builder of localized strings, rendering from constexpr tables generated by `CatalogCodegen`.
+/// </summary>
+/// <remarks>
+///		Templates are already prepared (constants substituted, template references flattened), so nothing is parsed
+/// 	or allocated at runtime except the generated string. Results are the same as `StringBuilder` loaded with the same catalog.
+/// </remarks>
+template <std::uint16_t NumSupportedLanguages, typename CharType = char, typename Allocator = std::allocator<CharType>>
+class StaticStringBuilder
+{
+public:
+	using StringType 			= std::basic_string<CharType, std::char_traits<CharType>, Allocator>;
+	using StringViewType 		= std::basic_string_view<CharType>;
+	using TranslationViewType 	= TranslationView<CharType>;
+
+	/// <summary>
+	///		Map (token name, value) used when substituting variable values for token names.
+	///		Same type as `StringBuilder::FormatVariables`.
+	/// </summary>
+	using FormatVariables = std::map<StringType, StringType, std::less<>,
+		typename std::allocator_traits<Allocator>::template rebind_alloc< std::pair<StringType const, StringType> >>;
+
+	/// <summary>
+	///		Creates builder from generated table.
+	/// </summary>
+	/// <param name="translations_">Translations, `NumSupportedLanguages` consecutive entries per template</param>
+	/// <param name="numTemplates_">Number of templates</param>
+	/// <param name="fallbackLanguage_">The fallback language</param>
+	constexpr StaticStringBuilder(TranslationViewType const* translations_, std::size_t numTemplates_, std::uint16_t fallbackLanguage_)
+		: _translations(translations_),
+		_numTemplates(numTemplates_),
+		_fallbackLanguage(fallbackLanguage_)
+	{
+	}
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType operator()(LanguageType lang_, IndexType templateIndex_, FormatVariables const& formatVariables_ = {}) const
+	{
+		return this->build(lang_, templateIndex_, formatVariables_);
+	}
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType build(LanguageType lang_, IndexType templateIndex_, FormatVariables const& formatVariables_ = {}) const
+	{
+		StringType result;
+		this->appendTo(result, lang_, templateIndex_, formatVariables_);
+		return result;
+	}
+
+	/// <summary>
+	///		Appends localized string in specified language, built from specified template, to a string of the caller.
+	/// </summary>
+	/// <param name="result_">String to append to. Nothing is allocated if its capacity is large enough.</param>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	template <typename ResultType, typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	void appendTo(ResultType& result_, LanguageType lang_, IndexType templateIndex_, FormatVariables const& formatVariables_ = {}) const
+	{
+		auto const translation = this->resolveTranslation( static_cast<std::uint16_t>(lang_), static_cast<std::size_t>(templateIndex_) );
+		if (translation.translated)
+			renderTranslation(result_, translation, formatVariables_);
+	}
+
+	/// <summary>
+	///		Generates localized string into the output buffer of a render context, using variables set in the context.
+	/// </summary>
+	/// <param name="context_">The context (e.g. `RenderContext::threadLocal()`)</param>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <returns>
+	///		View of the generated string, valid until the next render with the context. Empty if template does not exist.
+	/// </returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringViewType build(RenderContext<CharType, Allocator>& context_, LanguageType lang_, IndexType templateIndex_) const
+	{
+		auto& output = context_._output;
+		output.clear();
+
+		auto const translation = this->resolveTranslation( static_cast<std::uint16_t>(lang_), static_cast<std::size_t>(templateIndex_) );
+		if (translation.translated)
+			renderTranslation(output, translation, context_._variables);
+
+		return output;
+	}
+
+	/// <summary>
+	///		Determines whether specified template has translation in specified language.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template (integer or Enum type)</param>
+	/// <param name="lang_">The language (integer or Enum type)</param>
+	/// <returns>
+	///		Boolean.
+	/// </returns>
+	template <typename IndexType, typename LanguageType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	constexpr bool templateHasTranslation(IndexType templateIndex_, LanguageType lang_) const
+	{
+		return this->getTranslationView( static_cast<std::size_t>(templateIndex_), static_cast<std::uint16_t>(lang_) ).translated;
+	}
+
+	/// <summary>
+	///		Returns view of translation in exactly specified language (fallback language is not used).
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">The language</param>
+	/// <returns>The view. Not translated view if translation does not exist.</returns>
+	constexpr TranslationViewType getTranslationView(std::size_t templateIndex_, std::uint16_t lang_) const
+	{
+		if (templateIndex_ >= _numTemplates || lang_ >= NumSupportedLanguages)
+			return {};
+
+		return _translations[templateIndex_ * NumSupportedLanguages + lang_];
+	}
+
+	/// <returns>
+	///		Number of template slots (highest template index + 1).
+	/// </returns>
+	constexpr std::size_t getNumTemplates() const {
+		return _numTemplates;
+	}
+
+	/// <returns>
+	///		Fallback language index.
+	/// </returns>
+	constexpr std::uint16_t getFallbackLanguage() const {
+		return _fallbackLanguage;
+	}
+
+private:
+
+	/// <summary>
+	///		Finds translation in specified language or fallback language.
+	/// </summary>
+	/// <param name="lang_">The language</param>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <returns>The translation. Not translated view if neither exists.</returns>
+	constexpr TranslationViewType resolveTranslation(std::uint16_t lang_, std::size_t templateIndex_) const
+	{
+		auto const translation = this->getTranslationView(templateIndex_, lang_);
+		if (translation.translated)
+			return translation;
+
+		return this->getTranslationView(templateIndex_, _fallbackLanguage);
+	}
+
+	TranslationViewType const* 	_translations;
+	std::size_t 				_numTemplates;
+	std::uint16_t 				_fallbackLanguage;
+};
+
+} // namespace rexrn::loc
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <Rexrn/LocCpp/TranslationView.hpp>
+#include <Rexrn/LocCpp/MemoryUsage.hpp>
+#include <Rexrn/LocCpp/RenderContext.hpp>
+
 #include <vector>
 #include <string>
 #include <map>
@@ -8,50 +12,144 @@
 #include <type_traits>
 #include <optional>
 #include <string_view>
+#include <initializer_list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <limits>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_set>
 
 namespace rexrn::loc
 {
 
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+class StringBuilderOverlay;
+
+namespace detail
+{
+
+/// <summary>
+///		Determines whether type can be used as language or template index (integer or Enum type).
+/// </summary>
+template <typename T>
+constexpr bool isIndex = std::is_enum_v<T> || std::is_integral_v<T>;
+
+}
+
 /// <summary>
 ///		A builder of localized strings.
 /// 	Stores string templates and constants.
 /// </summary>
-template <std::uint16_t NumSupportedLanguages, typename CharType = char>
+/// <remarks>
+///		Every internal container and every generated string uses (a rebound copy of) `Allocator`.
+///		Use `rexrn::loc::pmr::StringBuilder` to place the catalog inside a `std::pmr::memory_resource`.
+/// </remarks>
+template <std::uint16_t NumSupportedLanguages, typename CharType = char, typename Allocator = std::allocator<CharType>>
 class StringBuilder
 {
 
 public:
-	using StringType 		= std::basic_string<CharType>;
+	using AllocatorType 	= Allocator;
+	using StringType 		= std::basic_string<CharType, std::char_traits<CharType>, Allocator>;
 	using StringViewType 	= std::basic_string_view<CharType>;
+	using TranslationViewType = TranslationView<CharType>;
+
+	/// <summary>
+	///		Pair describing where to insert (first, index in base format string) and what token (second).
+	/// </summary>
+	using FormatPoint 		= typename TranslationViewType::FormatPoint;
 
 private:
 
+	/// <summary>
+	///		Allocator type rebound to the `T` value type.
+	/// </summary>
+	template <typename T>
+	using RebindAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<T>;
+
+	/// <summary>
+	///		Vector using the builder's allocator.
+	/// </summary>
+	template <typename T>
+	using VectorType = std::vector<T, RebindAllocator<T>>;
+
 	/// <summary>
 	///		Helper structure used to describe single localized string template.
 	/// </summary>
 	struct LocStringTemplate
 	{
+		using FormatPoint = StringBuilder::FormatPoint;
+
+		/// <summary>
+		///		Translation with every template reference inlined.
+		/// </summary>
+		struct FlatTranslation
+		{
+			StringType 					formatBase;
+			VectorType<FormatPoint> 	formatPoints;
+
+			/// <summary>
+			///		False if a cyclic reference was left unresolved in this translation or in translations it depends on.
+			/// </summary>
+			bool 						acyclic = true;
+		};
+
 		/// <summary>
-		///		Pair describing where to insert (first, index in base format string) and what token (second).
+		///		Creates empty template which uses specified allocator for every translation.
 		/// </summary>
-		using FormatPoint = std::pair<std::size_t, StringViewType>;
+		/// <param name="allocator_">The allocator</param>
+		explicit LocStringTemplate(Allocator const& allocator_)
+			: formatPoints( makeFormatPoints(allocator_, std::make_index_sequence<NumSupportedLanguages>{}) )
+		{
+		}
 
 		/// <summary>
 		///		Array of format points for each translation.
 		/// </summary>
-		std::array<std::vector<FormatPoint>, NumSupportedLanguages> formatPoints;
+		std::array<VectorType<FormatPoint>, NumSupportedLanguages> formatPoints;
 
 		/// <summary>
 		///		Array of base format strings for each translation.
 		/// </summary>
 		std::array< std::optional<StringType>, NumSupportedLanguages> formatBase;
 
+		/// <summary>
+		///		Determines whether translation contains template references, e.g. "$(@12)".
+		/// </summary>
+		std::array<bool, NumSupportedLanguages> hasReferences{};
+
+		/// <summary>
+		///		Translations with template references inlined, computed by `freeze()`.
+		/// </summary>
+		std::array< std::optional<FlatTranslation>, NumSupportedLanguages> flattened;
+
 		/// <summary>
 		///		Determines whether template is translated to specified language.
 		/// </summary>
 		bool hasTranslation(std::uint16_t language_) const {
 			return formatBase[language_].has_value();
 		}
+
+		/// <summary>
+		///		Removes translation in specified language and releases its memory.
+		/// </summary>
+		void resetTranslation(std::uint16_t language_) {
+			formatBase[language_].reset();
+			formatPoints[language_].clear();
+			formatPoints[language_].shrink_to_fit();
+			hasReferences[language_] = false;
+			flattened[language_].reset();
+		}
+
+	private:
+		template <std::size_t... Indices>
+		static std::array<VectorType<FormatPoint>, NumSupportedLanguages> makeFormatPoints(Allocator const& allocator_, std::index_sequence<Indices...>)
+		{
+			return { ( static_cast<void>(Indices), VectorType<FormatPoint>(allocator_) )... };
+		}
 	};
 
 public:
@@ -59,7 +157,266 @@ public:
 	/// <summary>
 	///		Map (token name, value) used when substituting variable values for token names.
 	/// </summary>
-	using FormatVariables = std::map<StringType, StringType>;
+	/// <remarks>
+	///		`build` also accepts other maps, e.g. `std::map<std::string, std::string>`. Maps without heterogeneous lookup
+	/// 	(`std::less<>`) are searched with a temporary key, i.e. allocate for every token.
+	/// </remarks>
+	using FormatVariables = std::map<StringType, StringType, std::less<>, RebindAllocator< std::pair<StringType const, StringType> >>;
+
+	/// <summary>
+	///		Creates empty builder using default-constructed allocator.
+	/// </summary>
+	StringBuilder()
+		: StringBuilder( Allocator{} )
+	{
+	}
+
+	/// <summary>
+	///		Creates empty builder using specified allocator for catalog storage and generated strings.
+	/// </summary>
+	/// <param name="allocator_">The allocator</param>
+	explicit StringBuilder(Allocator const& allocator_)
+		: _allocator(allocator_),
+		_templates(allocator_),
+		_tokenNames(allocator_),
+		_constants(allocator_)
+	{
+	}
+
+	/// <summary>
+	///		Creates a copy of another builder.
+	/// </summary>
+	/// <param name="other_">The builder to copy</param>
+	StringBuilder(StringBuilder const& other_)
+		: StringBuilder( other_, std::allocator_traits<Allocator>::select_on_container_copy_construction(other_._allocator) )
+	{
+	}
+
+	/// <summary>
+	///		Creates a copy of another builder using specified allocator.
+	/// </summary>
+	/// <param name="other_">The builder to copy</param>
+	/// <param name="allocator_">The allocator</param>
+	/// <remarks>
+	///		Format points and constants refer to token names stored inside the builder,
+	///		so the copy has to re-point them to its own token name storage.
+	/// </remarks>
+	StringBuilder(StringBuilder const& other_, Allocator const& allocator_)
+		: StringBuilder(allocator_)
+	{
+		this->copyFrom(other_);
+	}
+
+	/// <summary>
+	///		Moves another builder. Token name storage is moved as a whole, so format points stay valid.
+	/// </summary>
+	/// <param name="other_">The builder to move</param>
+	StringBuilder(StringBuilder&& other_) noexcept
+		: _allocator(std::move(other_._allocator)),
+		_templates(std::move(other_._templates)),
+		_tokenNames(std::move(other_._tokenNames)),
+		_constants(std::move(other_._constants)),
+		_fallbackLanguage(other_._fallbackLanguage),
+		_frozen(other_._frozen),
+		_flattenedValid(other_._flattenedValid)
+	{
+		// Handles bound to the moved-from builder must not be used anymore.
+		++other_._version;
+	}
+
+	/// <summary>
+	///		Replaces content with a copy of another builder.
+	/// </summary>
+	/// <param name="other_">The builder to copy</param>
+	/// <remarks>
+	///		Allocator of the other builder is taken over if `propagate_on_container_copy_assignment` says so.
+	/// </remarks>
+	StringBuilder& operator=(StringBuilder const& other_);
+
+	/// <summary>
+	///		Replaces content with content of another builder.
+	/// </summary>
+	/// <param name="other_">The builder to move</param>
+	/// <remarks>
+	///		If allocators do not propagate and differ, nodes cannot be stolen and content is copied instead.
+	/// 	Does not throw if allocators propagate or always compare equal (e.g. `std::allocator`).
+	/// </remarks>
+	StringBuilder& operator=(StringBuilder&& other_) noexcept(
+			std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+			|| std::allocator_traits<Allocator>::is_always_equal::value
+		);
+
+	/// <returns>
+	///		Allocator used by the builder.
+	/// </returns>
+	Allocator getAllocator() const {
+		return _allocator;
+	}
+
+	/// <returns>
+	///		Allocator used by generated strings and rendering (and freezing) scratch space, unless specified otherwise:
+	///		copy of the catalog allocator made by `select_on_container_copy_construction`.
+	/// </returns>
+	/// <remarks>
+	///		For `std::pmr` this is the default resource, so rendering never grows the catalog's memory
+	/// 	and never touches its (possibly unsynchronized) resource. Stateful allocators which keep their state
+	/// 	when copied (e.g. an arena allocator) return the catalog allocator itself; pass an allocator to `build`
+	/// 	to keep generated strings out of the catalog's memory.
+	/// </remarks>
+	Allocator getResultAllocator() const {
+		return std::allocator_traits<Allocator>::select_on_container_copy_construction(_allocator);
+	}
+
+	/// <summary>
+	///		Handle of a (language, template) pair with translation, fallback and argument slots already resolved.
+	///		Rendering through the handle is the cheapest way to generate a string repeatedly.
+	/// </summary>
+	/// <remarks>
+	///		Created by `StringBuilder::bind`. The handle refers to the builder's storage and becomes invalid
+	/// 	once the builder is modified, frozen again or moved from (`isValid()` detects it); invalid handle generates empty strings.
+	/// 	The handle must not outlive the builder.
+	/// </remarks>
+	class BoundTemplate
+	{
+	public:
+		/// <summary>
+		///		Creates handle that is not bound to anything.
+		/// </summary>
+		BoundTemplate() = default;
+
+		/// <returns>
+		///		True if the handle is bound to existing translation and the builder was not modified since.
+		/// </returns>
+		bool isValid() const {
+			return _builder != nullptr && _builder->_version == _version;
+		}
+
+		/// <returns>
+		///		Number of argument slots (distinct token names, in order of first appearance).
+		/// </returns>
+		std::size_t getNumSlots() const {
+			return _slots.size();
+		}
+
+		/// <param name="slotIndex_">Index of the slot</param>
+		/// <returns>
+		///		Token name of the slot.
+		/// </returns>
+		StringViewType getSlotName(std::size_t slotIndex_) const {
+			return _slots[slotIndex_];
+		}
+
+		/// <summary>
+		///		Finds argument slot of specified token name.
+		/// </summary>
+		/// <param name="tokenName_">The token name</param>
+		/// <returns>Index of the slot. Empty optional if template does not use the token.</returns>
+		std::optional<std::size_t> findSlot(StringViewType tokenName_) const;
+
+		/// <summary>
+		///		Generates localized string.
+		/// </summary>
+		/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+		/// <returns>Generated string. Empty string if handle is not valid.</returns>
+		StringType build(FormatVariables const& formatVariables_ = {}) const;
+
+		/// <summary>
+		///		Generates localized string using positional arguments (one per slot, see `getSlotName`).
+		/// </summary>
+		/// <param name="arguments_">Values of slots. Slots without value are substituted by their token names.</param>
+		/// <returns>Generated string. Empty string if handle is not valid.</returns>
+		StringType build(std::initializer_list<StringViewType> arguments_) const
+		{
+			return this->build(arguments_.begin(), arguments_.size());
+		}
+
+		/// <summary>
+		///		Generates localized string using positional arguments (one per slot, see `getSlotName`).
+		/// </summary>
+		/// <param name="arguments_">Values of slots. Slots without value are substituted by their token names.</param>
+		/// <param name="numArguments_">Number of arguments</param>
+		/// <returns>Generated string. Empty string if handle is not valid.</returns>
+		StringType build(StringViewType const* arguments_, std::size_t numArguments_) const;
+
+		/// <summary>
+		///		Appends localized string generated using positional arguments to `result_`.
+		///		Lets the caller reuse one buffer for every render.
+		/// </summary>
+		/// <param name="result_">String to append to</param>
+		/// <param name="arguments_">Values of slots. Slots without value are substituted by their token names.</param>
+		/// <param name="numArguments_">Number of arguments</param>
+		/// <returns>False if handle is not valid (nothing is appended then).</returns>
+		bool appendTo(StringType& result_, StringViewType const* arguments_, std::size_t numArguments_) const;
+
+		/// <summary>
+		///		Generates localized string.
+		/// </summary>
+		/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+		/// <returns>Generated string. Empty string if handle is not valid.</returns>
+		StringType operator()(FormatVariables const& formatVariables_ = {}) const {
+			return this->build(formatVariables_);
+		}
+
+		/// <summary>
+		///		Generates localized string using positional arguments (one per slot, see `getSlotName`).
+		/// </summary>
+		/// <param name="arguments_">Values of slots. Slots without value are substituted by their token names.</param>
+		/// <returns>Generated string. Empty string if handle is not valid.</returns>
+		StringType operator()(std::initializer_list<StringViewType> arguments_) const {
+			return this->build(arguments_);
+		}
+
+	private:
+		friend class StringBuilder;
+
+		/// <summary>
+		///		Creates handle that is not bound to anything, using specified allocator for slot layout.
+		/// </summary>
+		explicit BoundTemplate(Allocator const& allocator_)
+			: _slots(allocator_),
+			_pointSlots(allocator_)
+		{
+		}
+
+		StringBuilder const* 		_builder = nullptr;
+		std::uint64_t 				_version = 0;
+
+		/// <summary>
+		///		Resolved translation (fallback language already applied).
+		/// </summary>
+		TranslationViewType 		_translation;
+
+		/// <summary>
+		///		Distinct token names.
+		/// </summary>
+		std::vector<StringViewType, RebindAllocator<StringViewType>> 	_slots;
+
+		/// <summary>
+		///		Slot index of every format point.
+		/// </summary>
+		std::vector<std::size_t, RebindAllocator<std::size_t>> 			_pointSlots;
+	};
+
+	/// <summary>
+	///		Single change of a translation, used by `applyTranslationUpdates`.
+	/// </summary>
+	struct TranslationUpdate
+	{
+		/// <summary>
+		///		Index of the template.
+		/// </summary>
+		std::size_t 				templateIndex;
+
+		/// <summary>
+		///		The language.
+		/// </summary>
+		std::uint16_t 				lang;
+
+		/// <summary>
+		///		New translation template string. Empty optional removes the translation.
+		/// </summary>
+		std::optional<StringType> 	translation;
+	};
 	
 	/// <summary>
 	///		Generates localized string in specified language, built from specified template.
@@ -68,9 +425,25 @@ public:
 	/// <param name="templateIndex_">Index of the string template</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	StringType operator()(std::uint16_t lang_, std::size_t templateIndex_, FormatVariables formatVariables_ = {}) const
+	template <typename VariablesType = FormatVariables>
+	StringType operator()(std::uint16_t lang_, std::size_t templateIndex_, VariablesType const& formatVariables_ = {}) const
+	{
+		return this->build(lang_, templateIndex_, formatVariables_);
+	}
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string</param>
+	/// <param name="templateIndex_">Index of the string template</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>
+	///		Generated string (using `getResultAllocator()`). Empty string if template does not exist.
+	/// </returns>
+	template <typename VariablesType = FormatVariables>
+	StringType build(std::uint16_t lang_, std::size_t templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
-		return this->build(lang_, templateIndex_, std::move(formatVariables_));
+		return this->build(lang_, templateIndex_, formatVariables_, this->getResultAllocator());
 	}
 
 	/// <summary>
@@ -79,8 +452,29 @@ public:
 	/// <param name="lang_">Language of the localized string</param>
 	/// <param name="templateIndex_">Index of the string template</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <param name="resultAllocator_">Allocator used by the generated string (e.g. per-request arena)</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	StringType build(std::uint16_t lang_, std::size_t templateIndex_, FormatVariables formatVariables_ = {}) const;
+	template <typename VariablesType = FormatVariables>
+	StringType build(std::uint16_t lang_, std::size_t templateIndex_, VariablesType const& formatVariables_, Allocator const& resultAllocator_) const;
+
+	/// <summary>
+	///		Context used to render without allocating.
+	/// </summary>
+	using RenderContextType = RenderContext<CharType, Allocator>;
+
+	/// <summary>
+	///		Generates localized string into the output buffer of a render context, using variables set in the context.
+	/// </summary>
+	/// <param name="context_">The context (e.g. `RenderContextType::threadLocal()`)</param>
+	/// <param name="lang_">Language of the localized string</param>
+	/// <param name="templateIndex_">Index of the string template</param>
+	/// <returns>
+	///		View of the generated string, valid until the next render with the context. Empty if template does not exist.
+	/// </returns>
+	/// <remarks>
+	///		Once context buffers are large enough, nothing is allocated.
+	/// </remarks>
+	StringViewType build(RenderContextType& context_, std::uint16_t lang_, std::size_t templateIndex_) const;
 
 	/// <summary>
 	///		Assigns string template.
@@ -118,6 +512,10 @@ public:
 	///		Removes translation for specified language in <b>every</b> template.
 	/// </summary>
 	/// <param name="lang_">The language</param>
+	/// <remarks>
+	///		Translations of other languages never resolve references to the removed one (unless it is the fallback language),
+	/// 	so they stay flattened.
+	/// </remarks>
 	void removeTranslation(std::uint16_t lang_);
 
 	/// <summary>
@@ -130,6 +528,17 @@ public:
 	/// </returns>
 	bool templateHasTranslation(std::size_t templateIndex_, std::uint16_t lang_) const;
 
+	/// <summary>
+	///		Resolves translation of specified template in specified language once, for repeated rendering.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string</param>
+	/// <param name="templateIndex_">Index of the string template</param>
+	/// <returns>
+	///		Handle of the translation. The handle is not valid if template does not exist,
+	/// 	or if it contains template references and builder is not frozen (call `freeze()` first).
+	/// </returns>
+	BoundTemplate bind(std::uint16_t lang_, std::size_t templateIndex_) const;
+
 	/// <summary>
 	///		Defines constant value.
 	/// </summary>
@@ -137,12 +546,24 @@ public:
 	/// <param name="value_">Value of the constant</param>
 	void setConstant(StringType name_, StringType value_);
 
+	/// <summary>
+	///		Sets or removes multiple translations as a single operation.
+	/// </summary>
+	/// <param name="updates_">The updates, applied in order</param>
+	/// <remarks>
+	///		Every translation is prepared before the first one is stored. If preparation fails (e.g. throws `std::bad_alloc`),
+	/// 	the builder is left unchanged, so it never contains only part of the updates.
+	/// </remarks>
+	template <typename UpdateRange>
+	void applyTranslationUpdates(UpdateRange const& updates_);
+
 	/// <summary>
 	///		Defines fallback language. If certain translation is not set, fallback language translation is used.
 	/// </summary>
 	/// <param name="fallbackLanguage_">The fallback language</param>
 	void setFallbackLanguage(std::uint16_t fallbackLanguage_) {
-		_fallbackLanguage = fallbackLanguage_;
+		_fallbackLanguage 	= fallbackLanguage_;
+		this->markModified();
 	}
 
 	/// <returns>
@@ -152,6 +573,78 @@ public:
 		return _fallbackLanguage;
 	}
 
+	/// <summary>
+	///		Inlines every template reference (token "$(@TemplateIndex)") into a flattened translation,
+	/// 	so that rendering a template composed of other templates is a single pass.
+	/// </summary>
+	/// <returns>
+	///		False if cyclic references were found. These are left unresolved and rendered as token names.
+	/// </returns>
+	/// <remarks>
+	///		Reference is resolved in the language of the translation containing it (or in the fallback language,
+	/// 	if referenced template is not translated). Call it after the catalog is loaded. Every later modification
+	/// 	unfreezes the builder: until next `freeze()` templates containing references are rendered recursively.
+	///
+	/// 	`applyTranslationUpdates` keeps flattened translations which do not depend on the updated templates,
+	/// 	so freezing again after a batch of updates only flattens the updated translations and their referrers.
+	/// 	Any other modification makes the next `freeze()` flatten everything again.
+	/// 	Bound templates are invalidated only if some flattened translation had to be replaced.
+	/// </remarks>
+	bool freeze();
+
+	/// <returns>
+	///		True if template references are flattened and builder was not modified since.
+	/// </returns>
+	bool isFrozen() const {
+		return _frozen;
+	}
+
+	/// <returns>
+	///		Number of template slots (highest template index + 1).
+	/// </returns>
+	std::size_t getNumTemplates() const {
+		return _templates.size();
+	}
+
+	/// <summary>
+	///		Memory usage report type.
+	/// </summary>
+	using MemoryUsageType = MemoryUsage<NumSupportedLanguages>;
+
+	/// <summary>
+	///		Default estimate of allocator bookkeeping per allocation (typical `malloc` header and rounding).
+	/// </summary>
+	static constexpr std::size_t DefaultAllocationOverhead = 2 * sizeof(void*);
+
+	/// <summary>
+	///		Computes heap memory used by the builder, broken down by language, template, token table and constants.
+	/// </summary>
+	/// <param name="allocationOverhead_">Estimated allocator bookkeeping per allocation</param>
+	/// <returns>The report.</returns>
+	/// <remarks>
+	///		Sizes of standard library internals (small string buffers, tree nodes) are estimated.
+	/// </remarks>
+	MemoryUsageType memoryUsage(std::size_t allocationOverhead_ = DefaultAllocationOverhead) const;
+
+	/// <summary>
+	///		Computes heap memory used by translations of specified language, same as `memoryUsage().languages[lang_]`.
+	/// </summary>
+	/// <param name="lang_">The language</param>
+	/// <param name="allocationOverhead_">Estimated allocator bookkeeping per allocation</param>
+	/// <returns>The memory used by the language.</returns>
+	MemoryBlock languageMemoryUsage(std::uint16_t lang_, std::size_t allocationOverhead_ = DefaultAllocationOverhead) const;
+
+	/// <summary>
+	///		Returns render-ready view of translation in exactly specified language (fallback language is not used).
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">The language</param>
+	/// <returns>
+	///		The view, valid until the builder is modified. Not translated view if translation does not exist
+	/// 	or if it contains template references and builder is not frozen.
+	/// </returns>
+	TranslationViewType getTranslationView(std::size_t templateIndex_, std::uint16_t lang_) const;
+
 
 	///////////////////////////////////////
 	// Template overloads:
@@ -165,11 +658,11 @@ public:
 	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename LanguageType, typename EnumType,
+	template <typename LanguageType, typename EnumType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<LanguageType> && std::is_enum_v<EnumType> > >
-	StringType operator()(LanguageType lang_, EnumType templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType operator()(LanguageType lang_, EnumType templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
-		return this->build(lang_, templateIndex_, std::move(formatVariables_));
+		return this->build(lang_, templateIndex_, formatVariables_);
 	}
 
 	/// <summary>
@@ -179,11 +672,11 @@ public:
 	/// <param name="templateIndex_">Index of the string template</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename LanguageType,
+	template <typename LanguageType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<LanguageType> > >
-	StringType operator()(LanguageType lang_, std::size_t templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType operator()(LanguageType lang_, std::size_t templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
-		return this->build(lang_, templateIndex_, std::move(formatVariables_));
+		return this->build(lang_, templateIndex_, formatVariables_);
 	}
 
 	/// <summary>
@@ -193,11 +686,11 @@ public:
 	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename EnumType,
+	template <typename EnumType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<EnumType> > >
-	StringType operator()(std::uint16_t lang_, EnumType templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType operator()(std::uint16_t lang_, EnumType templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
-		return this->build(lang_, templateIndex_, std::move(formatVariables_));
+		return this->build(lang_, templateIndex_, formatVariables_);
 	}
 
 	/// <summary>
@@ -207,14 +700,14 @@ public:
 	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename LanguageType, typename EnumType,
+	template <typename LanguageType, typename EnumType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<LanguageType> && std::is_enum_v<EnumType> > >
-	StringType build(LanguageType lang_, EnumType templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType build(LanguageType lang_, EnumType templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
 		return this->build(
 				static_cast<std::uint16_t>(lang_),
 				static_cast<std::size_t>(templateIndex_),
-				std::move(formatVariables_)
+				formatVariables_
 			);
 	}
 
@@ -225,14 +718,14 @@ public:
 	/// <param name="templateIndex_">Index of the string template</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename LanguageType,
+	template <typename LanguageType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<LanguageType> > >
-	StringType build(LanguageType lang_, std::size_t templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType build(LanguageType lang_, std::size_t templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
 		return this->build(
 				static_cast<std::uint16_t>(lang_),
 				templateIndex_,
-				std::move(formatVariables_)
+				formatVariables_
 			);
 	}
 
@@ -243,14 +736,14 @@ public:
 	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
 	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
 	/// <returns>Generated string. Empty string if template does not exist.</returns>
-	template <typename EnumType,
+	template <typename EnumType, typename VariablesType = FormatVariables,
 		typename = std::enable_if_t< std::is_enum_v<EnumType> > >
-	StringType build(std::uint16_t lang_, EnumType templateIndex_, FormatVariables formatVariables_ = {}) const
+	StringType build(std::uint16_t lang_, EnumType templateIndex_, VariablesType const& formatVariables_ = {}) const
 	{
 		return this->build(
 				lang_,
 				static_cast<std::size_t>(templateIndex_),
-				std::move(formatVariables_)
+				formatVariables_
 			);
 	}
 
@@ -446,36 +939,319 @@ public:
 		this->setFallbackLanguage( static_cast<std::uint16_t>(fallbackLanguage_) );
 	}
 
+	/// <summary>
+	///		Resolves translation of specified template in specified language once, for repeated rendering.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
+	/// <returns>Handle of the translation.</returns>
+	template <typename LanguageType, typename EnumType,
+		typename = std::enable_if_t< std::is_enum_v<LanguageType> && std::is_enum_v<EnumType> > >
+	BoundTemplate bind(LanguageType lang_, EnumType templateIndex_) const
+	{
+		return this->bind( static_cast<std::uint16_t>(lang_), static_cast<std::size_t>(templateIndex_) );
+	}
+
+	/// <summary>
+	///		Resolves translation of specified template in specified language once, for repeated rendering.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template</param>
+	/// <returns>Handle of the translation.</returns>
+	template <typename LanguageType,
+		typename = std::enable_if_t< std::is_enum_v<LanguageType> > >
+	BoundTemplate bind(LanguageType lang_, std::size_t templateIndex_) const
+	{
+		return this->bind( static_cast<std::uint16_t>(lang_), templateIndex_ );
+	}
+
+	/// <summary>
+	///		Resolves translation of specified template in specified language once, for repeated rendering.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string</param>
+	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
+	/// <returns>Handle of the translation.</returns>
+	template <typename EnumType,
+		typename = std::enable_if_t< std::is_enum_v<EnumType> > >
+	BoundTemplate bind(std::uint16_t lang_, EnumType templateIndex_) const
+	{
+		return this->bind( lang_, static_cast<std::size_t>(templateIndex_) );
+	}
+
+	/// <summary>
+	///		Generates localized string into the output buffer of a render context, using variables set in the context.
+	/// </summary>
+	/// <param name="context_">The context</param>
+	/// <param name="lang_">Language of the localized string (Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
+	/// <returns>View of the generated string, valid until the next render with the context.</returns>
+	template <typename LanguageType, typename EnumType,
+		typename = std::enable_if_t< std::is_enum_v<LanguageType> && std::is_enum_v<EnumType> > >
+	StringViewType build(RenderContextType& context_, LanguageType lang_, EnumType templateIndex_) const
+	{
+		return this->build( context_, static_cast<std::uint16_t>(lang_), static_cast<std::size_t>(templateIndex_) );
+	}
+
+	/// <summary>
+	///		Generates localized string into the output buffer of a render context, using variables set in the context.
+	/// </summary>
+	/// <param name="context_">The context</param>
+	/// <param name="lang_">Language of the localized string (Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template</param>
+	/// <returns>View of the generated string, valid until the next render with the context.</returns>
+	template <typename LanguageType,
+		typename = std::enable_if_t< std::is_enum_v<LanguageType> > >
+	StringViewType build(RenderContextType& context_, LanguageType lang_, std::size_t templateIndex_) const
+	{
+		return this->build( context_, static_cast<std::uint16_t>(lang_), templateIndex_ );
+	}
+
+	/// <summary>
+	///		Generates localized string into the output buffer of a render context, using variables set in the context.
+	/// </summary>
+	/// <param name="context_">The context</param>
+	/// <param name="lang_">Language of the localized string</param>
+	/// <param name="templateIndex_">Index of the string template (Enum type)</param>
+	/// <returns>View of the generated string, valid until the next render with the context.</returns>
+	template <typename EnumType,
+		typename = std::enable_if_t< std::is_enum_v<EnumType> > >
+	StringViewType build(RenderContextType& context_, std::uint16_t lang_, EnumType templateIndex_) const
+	{
+		return this->build( context_, lang_, static_cast<std::size_t>(templateIndex_) );
+	}
+
 private:
 
+	/// <summary>
+	///		Map (constant name, value). Names are views of `_tokenNames`.
+	/// </summary>
+	using ConstantMap = std::map<StringViewType, StringType, std::less<>, RebindAllocator< std::pair<StringViewType const, StringType> >>;
+
 	/// <summary>
 	///		Prepares format base and format points for single translation.
 	/// </summary>
 	/// <param name="translation_">The base translation template.</param>
 	/// <param name="formatBase_">The format base</param>
 	/// <param name="formatPoints_">The format points</param>
-	void prepareSingleTemplate(StringType translation_, StringType& formatBase_, std::vector<typename LocStringTemplate::FormatPoint> &formatPoints_);
+	/// <param name="inheritedConstants_">Constants used when a token is not one of `_constants` (see `StringBuilderOverlay`)</param>
+	void prepareSingleTemplate(StringType translation_, StringType& formatBase_, VectorType<FormatPoint> &formatPoints_,
+		ConstantMap const* inheritedConstants_ = nullptr);
+
+	/// <summary>
+	///		Assigns string template for specified language.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">The language</param>
+	/// <param name="translation_">The translation template string</param>
+	/// <param name="inheritedConstants_">Constants used when a token is not one of `_constants`</param>
+	void assignTranslation(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_, ConstantMap const* inheritedConstants_);
+
+	/// <summary>
+	///		Makes sure that template with specified index exists.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	void ensureTemplateExists(std::size_t templateIndex_);
+
+	template <std::uint16_t, typename, typename>
+	friend class StringBuilderOverlay;
+
+	/// <summary>
+	///		Stack of (template index, language) pairs being resolved, used to detect cyclic references.
+	/// </summary>
+	using ReferenceStack = VectorType< std::pair<std::size_t, std::uint16_t> >;
+
+	/// <summary>
+	///		Determines language of the translation used when specified template is requested in specified language.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">Requested language</param>
+	/// <returns>Either `lang_` or fallback language. Empty optional if neither is available.</returns>
+	std::optional<std::uint16_t> resolveLanguage(std::size_t templateIndex_, std::uint16_t lang_) const;
+
+	/// <summary>
+	///		Parses template index from template reference token name ("@TemplateIndex").
+	/// </summary>
+	/// <param name="tokenName_">The token name</param>
+	/// <returns>Template index. Empty optional if token is not a template reference.</returns>
+	static std::optional<std::size_t> referencedTemplate(StringViewType tokenName_);
+
+	/// <summary>
+	///		Determines whether any format point is a template reference.
+	/// </summary>
+	static bool containsReferences(VectorType<FormatPoint> const& formatPoints_);
+
+	/// <summary>
+	///		Translation used to render a template: the template and language of the translation.
+	/// </summary>
+	struct ResolvedTranslation
+	{
+		LocStringTemplate const* 	templ;
+		std::uint16_t 				lang;
+	};
+
+	/// <summary>
+	///		Finds translation used when specified template is requested in specified language.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">Requested language</param>
+	/// <returns>The translation. Empty optional if neither `lang_` nor fallback language is available.</returns>
+	std::optional<ResolvedTranslation> resolveTranslation(std::size_t templateIndex_, std::uint16_t lang_) const;
+
+	/// <summary>
+	///		Renders translation containing template references (of builder that is not frozen) recursively.
+	/// </summary>
+	/// <param name="result_">String to append to</param>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="translation_">The translation (already resolved)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <param name="stack_">Translations being rendered</param>
+	/// <param name="resolve_">
+	///		Function (template index, requested language) -> `std::optional<ResolvedTranslation>` resolving referenced templates,
+	///		e.g. `resolveTranslation` or lookup through layers of `StringBuilderOverlay`.
+	/// </param>
+	template <typename ResultType, typename VariablesType, typename StackType, typename ResolveFunc>
+	static void appendWithReferences(ResultType& result_, std::size_t templateIndex_, ResolvedTranslation const& translation_,
+		VariablesType const& formatVariables_, StackType& stack_, ResolveFunc const& resolve_);
+
+	/// <summary>
+	///		Strongly connected component of every translation in the graph of template references,
+	///		indexed by `templateIndex * NumSupportedLanguages + lang`. Translations referring to each other form one component.
+	/// </summary>
+	using ReferenceComponents = VectorType<std::size_t>;
+
+	/// <summary>
+	///		Finds strongly connected components of translations containing template references (Tarjan's algorithm).
+	/// </summary>
+	/// <returns>Component of every translation. Translations without references are left without component.</returns>
+	ReferenceComponents findReferenceComponents() const;
+
+	/// <summary>
+	///		Computes flattened translation (and translations of other components it depends on).
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">Language of the translation (already resolved)</param>
+	/// <param name="components_">Components found by `findReferenceComponents`</param>
+	/// <returns>False if cyclic reference was found.</returns>
+	bool flattenTranslation(std::size_t templateIndex_, std::uint16_t lang_, ReferenceComponents const& components_);
+
+	/// <summary>
+	///		Appends translation with template references resolved exactly like `appendWithReferences` does.
+	/// </summary>
+	/// <remarks>
+	///		Flattened translation of another component is reused: it cannot refer back to any translation on the stack.
+	///		Translations of the same component are expanded again, as their result depends on where the cycle was cut.
+	/// </remarks>
+	/// <param name="flat_">Flattened translation to append to</param>
+	/// <param name="templateIndex_">Index of the template</param>
+	/// <param name="lang_">Language of the translation (already resolved)</param>
+	/// <param name="components_">Components found by `findReferenceComponents`</param>
+	/// <param name="stack_">Translations being flattened</param>
+	/// <returns>False if cyclic reference was found.</returns>
+	bool appendFlattened(typename LocStringTemplate::FlatTranslation& flat_, std::size_t templateIndex_, std::uint16_t lang_,
+		ReferenceComponents const& components_, ReferenceStack& stack_);
+
+	/// <summary>
+	///		Finds translations referring to specified translations, either directly or through other referring translations.
+	/// </summary>
+	/// <param name="translations_">Translations (template index, language). Template index may exceed the number of templates.</param>
+	/// <returns>Translations (template index, language) whose flattened translation depends on the specified ones.</returns>
+	/// <remarks>
+	///		References resolve in the language of the referring translation or in the fallback language, so translations
+	/// 	of other languages are found only for fallback language translations.
+	/// </remarks>
+	ReferenceStack findReferringTranslations(ReferenceStack const& translations_) const;
+
+	/// <summary>
+	///		Accounts memory of single translation (including flattened one).
+	/// </summary>
+	/// <param name="block_">Block to add to</param>
+	/// <param name="templ_">The template</param>
+	/// <param name="lang_">The language</param>
+	/// <param name="allocationOverhead_">Estimated allocator bookkeeping per allocation</param>
+	/// <param name="accountFormatString_">Function (block, string) accounting format string</param>
+	template <typename AccountFormatString>
+	static void accountTranslation(MemoryBlock& block_, LocStringTemplate const& templ_, std::uint16_t lang_, std::size_t allocationOverhead_,
+		AccountFormatString const& accountFormatString_);
+
+	/// <summary>
+	///		Stores token name (if not stored yet).
+	/// </summary>
+	/// <param name="tokenName_">The token name</param>
+	/// <returns>View of the token name stored in `_tokenNames`.</returns>
+	StringViewType internTokenName(StringViewType tokenName_);
+
+	/// <summary>
+	///		Copies content of other builder into this (empty) builder.
+	/// </summary>
+	/// <param name="other_">The builder to copy</param>
+	void copyFrom(StringBuilder const& other_);
+
+	/// <summary>
+	///		Removes all templates, token names and constants.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	///		Invalidates flattened translations and bound templates.
+	/// </summary>
+	void markModified() {
+		_frozen 		= false;
+		_flattenedValid = false;
+		++_version;
+	}
+
+	/// <summary>
+	///		Allocator used by every container and every generated string.
+	/// </summary>
+	Allocator								_allocator;
 
 	/// <summary>
 	///		Vector of localized string templates.
 	/// </summary>
-	std::vector<LocStringTemplate>			_templates;
+	VectorType<LocStringTemplate>			_templates;
 
 	/// <summary>
 	///		Stored token names (memory optimization).
 	///		LocStringTemplate and m_constants use string_view pointing to the memory stored in the set.
 	/// </summary>
-	std::set<StringType>					_tokenNames;
+	std::set<StringType, std::less<>, RebindAllocator<StringType>>	_tokenNames;
 
 	/// <summary>
 	///		Map (token name, value) used when substituting values for token names when new template is first added. 
 	/// </summary>
-	std::map<StringViewType, StringType> 	_constants;
+	ConstantMap 							_constants;
 
 	/// <summary>
 	///		If certain translation is not set, fallback language translation is used. Zero by default.
 	/// </summary>
 	std::uint16_t 							_fallbackLanguage = 0;
+
+	/// <summary>
+	///		Determines whether flattened translations are up to date.
+	/// </summary>
+	bool 									_frozen = false;
+
+	/// <summary>
+	///		Determines whether flattened translations that were not reset are still up to date,
+	/// 	i.e. `freeze()` only has to flatten the missing ones.
+	/// </summary>
+	bool 									_flattenedValid = false;
+
+	/// <summary>
+	///		Incremented on every modification that may invalidate translation views (and bound templates).
+	/// </summary>
+	std::uint64_t 							_version = 0;
 };
 
+namespace pmr
+{
+
+/// <summary>
+///		String builder which stores the catalog and generates strings using `std::pmr::memory_resource`.
+/// </summary>
+template <std::uint16_t NumSupportedLanguages, typename CharType = char>
+using StringBuilder = loc::StringBuilder< NumSupportedLanguages, CharType, std::pmr::polymorphic_allocator<CharType> >;
+
+} // namespace pmr
+
 } // namespace rexrn::loc
\ No newline at end of file
@@ -6,121 +6,700 @@ namespace rexrn::loc
 {
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-typename StringBuilder<NumSupportedLanguages, CharType>::StringType // return type
-	StringBuilder<NumSupportedLanguages, CharType>::build(std::uint16_t lang_, std::size_t textIndex_, FormatVariables formatVariables_) const
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+template <typename VariablesType>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::StringType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::build(std::uint16_t lang_, std::size_t textIndex_, VariablesType const& formatVariables_, Allocator const& resultAllocator_) const
 {
-	StringType result;
-	if (_templates.size() > textIndex_)
-	{
-		auto const& templ = _templates[textIndex_];
-		
-		if (!templ.hasTranslation(lang_))
-		{
-			if (templ.hasTranslation(_fallbackLanguage))
-				lang_ = _fallbackLanguage;
-			else
-				return StringType{};
-		}
+	StringType result(resultAllocator_);
 
-		auto const& formatPoints = templ.formatPoints[lang_];
+	auto const lang = this->resolveLanguage(textIndex_, lang_);
+	if (!lang.has_value())
+		return result;
 
-		result = templ.formatBase[lang_].value();
-		// Optimize for big strings.
-		result.reserve(4 * 1024);
+	auto const& templ = _templates[textIndex_];
 
-		std::size_t offset = 0;
-		for (std::size_t i = 0; i < formatPoints.size(); i++)
-		{
-			auto const& token = formatPoints[i];
+	if (templ.hasReferences[*lang] && !(_frozen && templ.flattened[*lang].has_value()))
+	{
+		// Not flattened yet, slow path.
+		ReferenceStack stack(resultAllocator_);
+		appendWithReferences(result, textIndex_, { &templ, *lang }, formatVariables_, stack,
+			[this](std::size_t refIndex_, std::uint16_t refLang_) { return this->resolveTranslation(refIndex_, refLang_); });
+		return result;
+	}
 
-			// Try to find the token name inside formatVariables_:
-			StringType tokenName(token.second);
-			auto itVarName = formatVariables_.find(tokenName);
+	renderTranslation(result, this->getTranslationView(textIndex_, *lang), formatVariables_);
 
-			// Use either value from formatVariables_ or unformatted "$(TokenName)" if variable name not found:
-			StringType const& val = (itVarName != formatVariables_.end()) ? itVarName->second : tokenName;
+	return result;
+}
 
-			// Insert the value from above:
-			result.insert(token.first + offset, val);
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::StringViewType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::build(RenderContextType& context_, std::uint16_t lang_, std::size_t templateIndex_) const
+{
+	auto& output = context_._output;
+	output.clear();
 
-			// Track offset because string gets longer as we insert values to it
-			offset += val.size();
-		}
+	auto const lang = this->resolveLanguage(templateIndex_, lang_);
+	if (!lang.has_value())
+		return output;
 
-		result.shrink_to_fit();
+	auto const& templ = _templates[templateIndex_];
+
+	if (templ.hasReferences[*lang] && !(_frozen && templ.flattened[*lang].has_value()))
+	{
+		// Not flattened yet, slow path (still without allocations, the stack is kept in the context).
+		context_._referenceStack.clear();
+		appendWithReferences(output, templateIndex_, { &templ, *lang }, context_._variables, context_._referenceStack,
+			[this](std::size_t refIndex_, std::uint16_t refLang_) { return this->resolveTranslation(refIndex_, refLang_); });
+		return output;
 	}
 
-	return result;
+	renderTranslation(output, this->getTranslationView(templateIndex_, *lang), context_._variables);
+
+	return output;
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::setTemplate(std::size_t templateIndex_, std::array<StringType, NumSupportedLanguages> const & templateTranslations_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::setTemplate(std::size_t templateIndex_, std::array<StringType, NumSupportedLanguages> const & templateTranslations_)
 {
-	if (_templates.size() <= templateIndex_) {
-		_templates.resize(templateIndex_ + 1);
-	}
+	this->ensureTemplateExists(templateIndex_);
 
-	LocStringTemplate templ;
+	LocStringTemplate templ(_allocator);
 
 	for (std::size_t i = 0; i < NumSupportedLanguages; ++i)
 	{
 		// Initialize std::optional
-		templ.formatBase[i] = StringType{};
+		templ.formatBase[i].emplace(_allocator);
 
 		this->prepareSingleTemplate( templateTranslations_[i], templ.formatBase[i].value(), templ.formatPoints[i]) ;
+		templ.hasReferences[i] = containsReferences(templ.formatPoints[i]);
 	}
 
 	_templates[templateIndex_] = std::move(templ);
+	this->markModified();
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::setTemplateTranslation(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::setTemplateTranslation(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_)
 {
-	if (_templates.size() <= templateIndex_) {
-		_templates.resize(templateIndex_ + 1);
-	}
+	this->assignTranslation(templateIndex_, lang_, std::move(translation_), nullptr);
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::assignTranslation(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_,
+		ConstantMap const* inheritedConstants_)
+{
+	this->ensureTemplateExists(templateIndex_);
+
+	auto& templ = _templates[templateIndex_];
 
 	// Clear previous format points
-	_templates[templateIndex_].formatPoints[lang_].clear();
+	templ.resetTranslation(lang_);
 	// Initialize std::optional
-	_templates[templateIndex_].formatBase[lang_] = StringType{};
+	templ.formatBase[lang_].emplace(_allocator);
 
 	this->prepareSingleTemplate(
-			translation_,
-			_templates[templateIndex_].formatBase[lang_].value(),
-			_templates[templateIndex_].formatPoints[lang_]
+			std::move(translation_),
+			templ.formatBase[lang_].value(),
+			templ.formatPoints[lang_],
+			inheritedConstants_
 		);
+	templ.hasReferences[lang_] = containsReferences(templ.formatPoints[lang_]);
+
+	this->markModified();
 }
 
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::removeTemplateTranslation(std::size_t templateIndex_, std::uint16_t lang_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::removeTemplateTranslation(std::size_t templateIndex_, std::uint16_t lang_)
 {
 	if (templateIndex_ >= _templates.size())
 		return;
 
-	_templates[templateIndex_].formatBase[lang_].reset();
-	_templates[templateIndex_].formatPoints[lang_].clear();
+	_templates[templateIndex_].resetTranslation(lang_);
+	this->markModified();
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::removeTranslation(std::uint16_t lang_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::removeTranslation(std::uint16_t lang_)
 {
 	for(std::size_t i = 0; i < _templates.size(); ++i)
 	{
-		_templates[i].formatBase[lang_].reset();
-		_templates[i].formatPoints[lang_].clear();
+		_templates[i].resetTranslation(lang_);
+	}
+
+	if (lang_ == _fallbackLanguage)
+		this->markModified();
+	else
+		++_version; // Views of removed translations are invalid, flattened translations of other languages are not.
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::BoundTemplate // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::bind(std::uint16_t lang_, std::size_t templateIndex_) const
+{
+	BoundTemplate handle(this->getResultAllocator());
+
+	auto const lang = this->resolveLanguage(templateIndex_, lang_);
+	if (!lang.has_value())
+		return handle;
+
+	// Not translated view means unflattened template references.
+	auto const translation = this->getTranslationView(templateIndex_, *lang);
+	if (!translation.translated)
+		return handle;
+
+	handle._builder 	= this;
+	handle._version 	= _version;
+	handle._translation = translation;
+
+	// Token names are usually few, linear search is fine.
+	handle._pointSlots.reserve(translation.numFormatPoints);
+	for (std::size_t i = 0; i < translation.numFormatPoints; ++i)
+	{
+		auto const slot = handle.findSlot(translation.formatPoints[i].second);
+		if (slot.has_value())
+			handle._pointSlots.push_back(*slot);
+		else
+		{
+			handle._pointSlots.push_back(handle._slots.size());
+			handle._slots.push_back(translation.formatPoints[i].second);
+		}
+	}
+
+	return handle;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+std::optional<std::size_t> StringBuilder<NumSupportedLanguages, CharType, Allocator>::BoundTemplate::findSlot(StringViewType tokenName_) const
+{
+	auto it = std::find(_slots.begin(), _slots.end(), tokenName_);
+	if (it == _slots.end())
+		return std::nullopt;
+
+	return static_cast<std::size_t>(it - _slots.begin());
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::StringType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::BoundTemplate::build(FormatVariables const& formatVariables_) const
+{
+	if (!this->isValid())
+		return StringType{};
+
+	StringType result(_builder->getResultAllocator());
+	renderTranslation(result, _translation, formatVariables_);
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::StringType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::BoundTemplate::build(StringViewType const* arguments_, std::size_t numArguments_) const
+{
+	if (!this->isValid())
+		return StringType{};
+
+	StringType result(_builder->getResultAllocator());
+	this->appendTo(result, arguments_, numArguments_);
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::BoundTemplate::appendTo(StringType& result_, StringViewType const* arguments_, std::size_t numArguments_) const
+{
+	if (!this->isValid())
+		return false;
+
+	renderTranslationWith(result_, _translation, [&](std::size_t pointIndex_) {
+			std::size_t const slot = _pointSlots[pointIndex_];
+			return (slot < numArguments_) ? arguments_[slot] : _translation.formatPoints[pointIndex_].second;
+		});
+	return true;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::freeze()
+{
+	bool acyclic = true;
+	bool missingFlattened = false;
+	bool droppedFlattened = false;
+
+	for (auto& templ : _templates)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			if (!_flattenedValid && templ.flattened[lang].has_value())
+			{
+				templ.flattened[lang].reset();
+				droppedFlattened = true;
+			}
+
+			missingFlattened = missingFlattened || (templ.hasReferences[lang] && !templ.flattened[lang].has_value());
+		}
+	}
+
+	// Components are needed only to flatten translations again, kept ones are reused as they are.
+	auto const components = missingFlattened ? this->findReferenceComponents() : ReferenceComponents(this->getResultAllocator());
+	for (std::size_t i = 0; i < _templates.size(); ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			if (_templates[i].hasReferences[lang])
+				acyclic = this->flattenTranslation(i, lang, components) && acyclic;
+		}
+	}
+
+	_frozen 		= true;
+	_flattenedValid = true;
+
+	// Views into kept flattened translations stay valid, so repeated `freeze()` does not invalidate bound templates.
+	if (missingFlattened || droppedFlattened)
+		++_version; // Flattened translations were replaced.
+	return acyclic;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::TranslationViewType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::getTranslationView(std::size_t templateIndex_, std::uint16_t lang_) const
+{
+	if (!this->templateHasTranslation(templateIndex_, lang_))
+		return {};
+
+	auto const& templ = _templates[templateIndex_];
+	if (templ.hasReferences[lang_])
+	{
+		if (!_frozen || !templ.flattened[lang_].has_value())
+			return {};
+
+		auto const& flat = templ.flattened[lang_].value();
+		return { flat.formatBase, flat.formatPoints.data(), flat.formatPoints.size(), true };
+	}
+
+	return { templ.formatBase[lang_].value(), templ.formatPoints[lang_].data(), templ.formatPoints[lang_].size(), true };
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::MemoryUsageType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::memoryUsage(std::size_t allocationOverhead_) const
+{
+	MemoryUsageType usage;
+	usage.templates.resize(_templates.size());
+
+	detail::accountVector(usage.templateTable, _templates, allocationOverhead_);
+
+	// Non-empty format strings seen so far, to find duplicates:
+	std::unordered_set<StringViewType> formatStrings;
+	auto const accountFormatString = [&](MemoryBlock& block_, StringType const& str_) {
+			detail::accountString(block_, str_, allocationOverhead_);
+
+			if (!str_.empty() && !formatStrings.insert(StringViewType(str_)).second)
+			{
+				usage.numDuplicatedStrings 	+= 1;
+				usage.duplicatedStringBytes += str_.size() * sizeof(CharType);
+			}
+		};
+
+	for (std::size_t i = 0; i < _templates.size(); ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			MemoryBlock block;
+			accountTranslation(block, _templates[i], lang, allocationOverhead_, accountFormatString);
+
+			usage.languages[lang] 	+= block;
+			usage.templates[i] 		+= block;
+		}
+	}
+
+	for (auto const& tokenName : _tokenNames)
+	{
+		detail::accountTreeNode<StringType>(usage.tokenNames, allocationOverhead_);
+		detail::accountString(usage.tokenNames, tokenName, allocationOverhead_);
+	}
+
+	for (auto const& constant : _constants)
+	{
+		detail::accountTreeNode< std::pair<StringViewType const, StringType> >(usage.constants, allocationOverhead_);
+		detail::accountString(usage.constants, constant.second, allocationOverhead_);
 	}
+
+	usage.total += usage.templateTable;
+	for (auto const& language : usage.languages)
+		usage.total += language;
+	usage.total += usage.tokenNames;
+	usage.total += usage.constants;
+
+	return usage;
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-bool StringBuilder<NumSupportedLanguages, CharType>::templateHasTranslation(std::size_t templateIndex_, std::uint16_t lang_) const
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+MemoryBlock StringBuilder<NumSupportedLanguages, CharType, Allocator>::languageMemoryUsage(std::uint16_t lang_, std::size_t allocationOverhead_) const
+{
+	MemoryBlock block;
+	for (auto const& templ : _templates)
+	{
+		accountTranslation(block, templ, lang_, allocationOverhead_, [&](MemoryBlock& block_, StringType const& str_) {
+				detail::accountString(block_, str_, allocationOverhead_);
+			});
+	}
+
+	return block;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+template <typename AccountFormatString>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::accountTranslation(MemoryBlock& block_, LocStringTemplate const& templ_, std::uint16_t lang_,
+		std::size_t allocationOverhead_, AccountFormatString const& accountFormatString_)
+{
+	if (templ_.hasTranslation(lang_))
+	{
+		detail::accountVector(block_, templ_.formatPoints[lang_], allocationOverhead_);
+		accountFormatString_(block_, templ_.formatBase[lang_].value());
+	}
+
+	if (auto const& flat = templ_.flattened[lang_])
+	{
+		detail::accountVector(block_, flat->formatPoints, allocationOverhead_);
+		accountFormatString_(block_, flat->formatBase);
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+std::optional<std::uint16_t> StringBuilder<NumSupportedLanguages, CharType, Allocator>::resolveLanguage(std::size_t templateIndex_, std::uint16_t lang_) const
+{
+	if (templateIndex_ >= _templates.size())
+		return std::nullopt;
+
+	auto const& templ = _templates[templateIndex_];
+	if (templ.hasTranslation(lang_))
+		return lang_;
+	if (templ.hasTranslation(_fallbackLanguage))
+		return _fallbackLanguage;
+
+	return std::nullopt;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+std::optional<std::size_t> StringBuilder<NumSupportedLanguages, CharType, Allocator>::referencedTemplate(StringViewType tokenName_)
+{
+	if (tokenName_.size() < 2 || tokenName_[0] != '@')
+		return std::nullopt;
+
+	std::size_t templateIndex = 0;
+	for (std::size_t i = 1; i < tokenName_.size(); ++i)
+	{
+		if (tokenName_[i] < '0' || tokenName_[i] > '9')
+			return std::nullopt;
+
+		std::size_t const digit = static_cast<std::size_t>(tokenName_[i] - '0');
+		if (templateIndex > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+			return std::nullopt;
+
+		templateIndex = templateIndex * 10 + digit;
+	}
+
+	return templateIndex;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::containsReferences(VectorType<FormatPoint> const& formatPoints_)
+{
+	return std::any_of(formatPoints_.begin(), formatPoints_.end(),
+			[](auto const& token_) { return referencedTemplate(token_.second).has_value(); }
+		);
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+auto StringBuilder<NumSupportedLanguages, CharType, Allocator>::resolveTranslation(std::size_t templateIndex_, std::uint16_t lang_) const
+	-> std::optional<ResolvedTranslation>
+{
+	auto const lang = this->resolveLanguage(templateIndex_, lang_);
+	if (!lang.has_value())
+		return std::nullopt;
+
+	return ResolvedTranslation{ &_templates[templateIndex_], *lang };
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+template <typename ResultType, typename VariablesType, typename StackType, typename ResolveFunc>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::appendWithReferences(ResultType& result_, std::size_t templateIndex_,
+		ResolvedTranslation const& translation_, VariablesType const& formatVariables_, StackType& stack_, ResolveFunc const& resolve_)
+{
+	auto const& formatPoints	= translation_.templ->formatPoints[translation_.lang];
+	StringViewType const base	= translation_.templ->formatBase[translation_.lang].value();
+
+	stack_.push_back({ templateIndex_, translation_.lang });
+
+	std::size_t basePos = 0;
+	for (auto const& token : formatPoints)
+	{
+		result_.append(base.substr(basePos, token.first - basePos));
+		basePos = token.first;
+
+		if (auto refIndex = referencedTemplate(token.second))
+		{
+			auto const refTranslation = resolve_(*refIndex, translation_.lang);
+			if (refTranslation.has_value() && std::find(stack_.begin(), stack_.end(), std::make_pair(*refIndex, refTranslation->lang)) == stack_.end())
+			{
+				appendWithReferences(result_, *refIndex, *refTranslation, formatVariables_, stack_, resolve_);
+				continue;
+			}
+			// Unresolved or cyclic reference is treated as any other token.
+		}
+
+		auto itVarName = detail::findVariable(formatVariables_, token.second);
+		result_.append( (itVarName != formatVariables_.end()) ? StringViewType(itVarName->second) : token.second );
+	}
+	result_.append(base.substr(basePos));
+
+	stack_.pop_back();
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::ReferenceComponents // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::findReferenceComponents() const
+{
+	constexpr std::size_t Unvisited = std::numeric_limits<std::size_t>::max();
+
+	auto const scratchAllocator = this->getResultAllocator();
+	std::size_t const numTranslations = _templates.size() * NumSupportedLanguages;
+
+	ReferenceComponents components(numTranslations, Unvisited, scratchAllocator);
+	VectorType<std::size_t> order(numTranslations, Unvisited, scratchAllocator);
+	VectorType<std::size_t> lowLink(numTranslations, 0, scratchAllocator);
+	VectorType<std::size_t> stack(scratchAllocator);
+	std::size_t numVisited = 0;
+	std::size_t numComponents = 0;
+
+	auto const visit = [&](auto const& self_, std::size_t node_) -> void
+		{
+			order[node_] = lowLink[node_] = numVisited++;
+			stack.push_back(node_);
+
+			std::size_t const templateIndex = node_ / NumSupportedLanguages;
+			auto const lang = static_cast<std::uint16_t>(node_ % NumSupportedLanguages);
+			for (auto const& token : _templates[templateIndex].formatPoints[lang])
+			{
+				auto const refIndex = referencedTemplate(token.second);
+				auto const refLang = refIndex.has_value() ? this->resolveLanguage(*refIndex, lang) : std::nullopt;
+
+				// Translations without references never take part in a cycle.
+				if (!refLang.has_value() || !_templates[*refIndex].hasReferences[*refLang])
+					continue;
+
+				std::size_t const refNode = *refIndex * NumSupportedLanguages + *refLang;
+				if (order[refNode] == Unvisited)
+				{
+					self_(self_, refNode);
+					lowLink[node_] = std::min(lowLink[node_], lowLink[refNode]);
+				}
+				else if (components[refNode] == Unvisited) // Still on the stack.
+					lowLink[node_] = std::min(lowLink[node_], order[refNode]);
+			}
+
+			if (lowLink[node_] != order[node_])
+				return;
+
+			std::size_t member;
+			do
+			{
+				member = stack.back();
+				stack.pop_back();
+				components[member] = numComponents;
+			} while (member != node_);
+
+			++numComponents;
+		};
+
+	for (std::size_t node = 0; node < numTranslations; ++node)
+	{
+		if (order[node] == Unvisited && _templates[node / NumSupportedLanguages].hasReferences[node % NumSupportedLanguages])
+			visit(visit, node);
+	}
+
+	return components;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::flattenTranslation(std::size_t templateIndex_, std::uint16_t lang_,
+		ReferenceComponents const& components_)
+{
+	using FlatTranslation = typename LocStringTemplate::FlatTranslation;
+
+	auto& templ = _templates[templateIndex_];
+	if (!templ.hasReferences[lang_])
+		return true; // Nothing to do.
+	if (templ.flattened[lang_].has_value())
+		return templ.flattened[lang_]->acyclic; // Already done.
+
+	FlatTranslation flat{ StringType(_allocator), VectorType<FormatPoint>(_allocator) };
+	ReferenceStack stack(this->getResultAllocator());
+
+	bool const acyclic = this->appendFlattened(flat, templateIndex_, lang_, components_, stack);
+
+	flat.acyclic = acyclic;
+	flat.formatPoints.shrink_to_fit();
+	flat.formatBase.shrink_to_fit();
+	templ.flattened[lang_].emplace(std::move(flat));
+
+	return acyclic;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::appendFlattened(typename LocStringTemplate::FlatTranslation& flat_,
+		std::size_t templateIndex_, std::uint16_t lang_, ReferenceComponents const& components_, ReferenceStack& stack_)
+{
+	auto const& templ = _templates[templateIndex_];
+	auto const component = components_[templateIndex_ * NumSupportedLanguages + lang_];
+
+	stack_.push_back({ templateIndex_, lang_ });
+
+	bool acyclic = true;
+	StringViewType const base = templ.formatBase[lang_].value();
+
+	std::size_t basePos = 0;
+	for (auto const& token : templ.formatPoints[lang_])
+	{
+		flat_.formatBase.append(base.substr(basePos, token.first - basePos));
+		basePos = token.first;
+
+		if (auto refIndex = referencedTemplate(token.second))
+		{
+			auto const refLang = this->resolveLanguage(*refIndex, lang_);
+			if (refLang.has_value())
+			{
+				if (std::find(stack_.begin(), stack_.end(), std::make_pair(*refIndex, *refLang)) == stack_.end())
+				{
+					auto const& refTempl = _templates[*refIndex];
+					bool const refHasReferences = refTempl.hasReferences[*refLang];
+
+					if (refHasReferences && components_[*refIndex * NumSupportedLanguages + *refLang] == component)
+					{
+						acyclic = this->appendFlattened(flat_, *refIndex, *refLang, components_, stack_) && acyclic;
+						continue;
+					}
+
+					if (refHasReferences)
+						acyclic = this->flattenTranslation(*refIndex, *refLang, components_) && acyclic;
+
+					// Referenced translation is either flat by itself or was flattened above.
+					StringViewType const refBase = refHasReferences ? refTempl.flattened[*refLang]->formatBase : refTempl.formatBase[*refLang].value();
+					auto const& refPoints = refHasReferences ? refTempl.flattened[*refLang]->formatPoints : refTempl.formatPoints[*refLang];
+
+					std::size_t const offset = flat_.formatBase.size();
+					flat_.formatBase.append(refBase);
+					for (auto const& refToken : refPoints)
+						flat_.formatPoints.push_back({ offset + refToken.first, refToken.second });
+					continue;
+				}
+
+				acyclic = false;
+			}
+			// Unresolved or cyclic reference is treated as any other token.
+		}
+
+		flat_.formatPoints.push_back({ flat_.formatBase.size(), token.second });
+	}
+	flat_.formatBase.append(base.substr(basePos));
+
+	stack_.pop_back();
+	return acyclic;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::ReferenceStack // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::findReferringTranslations(ReferenceStack const& translations_) const
+{
+	auto const scratchAllocator = this->getResultAllocator();
+
+	// References to templates that do not exist and are not being added cannot depend on anything.
+	std::size_t numTemplates = _templates.size();
+	for (auto const& translation : translations_)
+		numTemplates = std::max(numTemplates, translation.first + 1);
+
+	// Referring translations of every template:
+	VectorType<ReferenceStack> referrers(numTemplates, ReferenceStack(scratchAllocator), scratchAllocator);
+	for (std::size_t i = 0; i < _templates.size(); ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			if (!_templates[i].hasReferences[lang])
+				continue;
+
+			for (auto const& token : _templates[i].formatPoints[lang])
+			{
+				auto const refIndex = referencedTemplate(token.second);
+				if (refIndex.has_value() && *refIndex < numTemplates)
+					referrers[*refIndex].push_back({ i, lang });
+			}
+		}
+	}
+
+	ReferenceStack result(scratchAllocator);
+	ReferenceStack pending(scratchAllocator);
+	VectorType<bool> visited(numTemplates * NumSupportedLanguages, false, scratchAllocator);
+
+	auto const visit = [&](std::pair<std::size_t, std::uint16_t> const& translation_) {
+			auto&& seen = visited[translation_.first * NumSupportedLanguages + translation_.second];
+			if (!seen)
+			{
+				seen = true;
+				pending.push_back(translation_);
+			}
+		};
+
+	for (auto const& translation : translations_)
+		visit(translation);
+
+	while (!pending.empty())
+	{
+		auto const [templateIndex, lang] = pending.back();
+		pending.pop_back();
+
+		for (auto const& referrer : referrers[templateIndex])
+		{
+			// Reference in other language resolves to this translation only through the fallback language.
+			if (referrer.second != lang && lang != _fallbackLanguage)
+				continue;
+
+			if (!visited[referrer.first * NumSupportedLanguages + referrer.second])
+				result.push_back(referrer);
+			visit(referrer);
+		}
+	}
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilder<NumSupportedLanguages, CharType, Allocator>::templateHasTranslation(std::size_t templateIndex_, std::uint16_t lang_) const
 {
 	if (templateIndex_ >= _templates.size())
 		return false;
@@ -129,8 +708,22 @@ bool StringBuilder<NumSupportedLanguages, CharType>::templateHasTranslation(std:
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::prepareSingleTemplate(StringType translation_, StringType& formatBase_, std::vector<typename LocStringTemplate::FormatPoint> &formatPoints_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::ensureTemplateExists(std::size_t templateIndex_)
+{
+	if (_templates.size() <= templateIndex_)
+	{
+		// Templates are not default-constructible, every one of them needs the allocator.
+		_templates.reserve(templateIndex_ + 1);
+		while (_templates.size() <= templateIndex_)
+			_templates.emplace_back(_allocator);
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::prepareSingleTemplate(StringType translation_, StringType& formatBase_, VectorType<FormatPoint> &formatPoints_,
+		ConstantMap const* inheritedConstants_)
 {
 	std::size_t tokenStart = std::numeric_limits<std::size_t>::max();
 	
@@ -160,8 +753,15 @@ void StringBuilder<NumSupportedLanguages, CharType>::prepareSingleTemplate(Strin
 				StringViewType tokenName( tokenNameStart, tokenNameLength );
 
 				// Check if can do in-place constant replacement.
-				auto itConstant = _constants.find(tokenName);
-				if (itConstant != _constants.end())
+				auto itConstant = std::as_const(_constants).find(tokenName);
+				bool isConstant = (itConstant != _constants.end());
+				if (!isConstant && inheritedConstants_)
+				{
+					itConstant = inheritedConstants_->find(tokenName);
+					isConstant = (itConstant != inheritedConstants_->end());
+				}
+
+				if (isConstant)
 				{
 					translation_.replace(tokenStart, tokenLength + 1, itConstant->second);
 					chIndex += itConstant->second.size();
@@ -169,10 +769,9 @@ void StringBuilder<NumSupportedLanguages, CharType>::prepareSingleTemplate(Strin
 				}
 				else // This is not constant
 				{
-					auto[itFoundTokenName, added] = _tokenNames.insert(StringType(tokenName));
 					// Create new format point at tokenStart.
-					formatPoints_.push_back({ tokenStart, *itFoundTokenName });
-					translation_.replace(tokenStart, tokenLength + 1, "");
+					formatPoints_.push_back({ tokenStart, this->internTokenName(tokenName) });
+					translation_.erase(tokenStart, tokenLength + 1);
 					chIndex -= tokenLength + 1;
 				}
 
@@ -187,12 +786,223 @@ void StringBuilder<NumSupportedLanguages, CharType>::prepareSingleTemplate(Strin
 }
 
 //////////////////////////////////////////////////////////////
-template <std::uint16_t NumSupportedLanguages, typename CharType>
-void StringBuilder<NumSupportedLanguages, CharType>::setConstant(StringType name_, StringType value_)
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::setConstant(StringType name_, StringType value_)
+{
+	StringViewType const name = this->internTokenName(name_);
+
+	_constants.insert_or_assign(name, std::move(value_));
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+template <typename UpdateRange>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::applyTranslationUpdates(UpdateRange const& updates_)
+{
+	using FormatPoints = VectorType<FormatPoint>;
+
+	struct PreparedUpdate
+	{
+		std::size_t 				templateIndex;
+		std::uint16_t 				lang;
+		std::optional<StringType> 	formatBase;
+		FormatPoints 				formatPoints;
+		bool 						hasReferences;
+	};
+
+	// Phase 1: prepare everything aside. Nothing visible changes yet.
+	VectorType<PreparedUpdate> prepared(_allocator);
+	std::size_t numTemplatesNeeded = 0;
+
+	for (auto const& update : updates_)
+	{
+		PreparedUpdate& p = prepared.emplace_back( PreparedUpdate{ update.templateIndex, update.lang, std::nullopt, FormatPoints(_allocator), false } );
+
+		if (update.translation.has_value())
+		{
+			p.formatBase.emplace(_allocator);
+			this->prepareSingleTemplate(*update.translation, p.formatBase.value(), p.formatPoints);
+			p.hasReferences = containsReferences(p.formatPoints);
+
+			numTemplatesNeeded = std::max(numTemplatesNeeded, update.templateIndex + 1);
+		}
+	}
+
+	// Flattened translations depending on the updated translations are flattened again by the next `freeze()`,
+	// the rest is kept. References did not change except in the updated translations, which are reset anyway.
+	ReferenceStack referrers(this->getResultAllocator());
+	if (_flattenedValid)
+	{
+		ReferenceStack updatedTranslations(this->getResultAllocator());
+		updatedTranslations.reserve(prepared.size());
+		for (auto const& p : prepared)
+			updatedTranslations.push_back({ p.templateIndex, p.lang });
+
+		referrers = this->findReferringTranslations(updatedTranslations);
+	}
+
+	if (numTemplatesNeeded > 0)
+		this->ensureTemplateExists(numTemplatesNeeded - 1);
+
+	// Phase 2: commit. Swapping containers with equal allocators does not throw.
+	for (auto& p : prepared)
+	{
+		if (p.templateIndex >= _templates.size())
+			continue; // Removal of translation that never existed.
+
+		auto& templ = _templates[p.templateIndex];
+		templ.formatBase[p.lang].swap(p.formatBase);
+		templ.formatPoints[p.lang].swap(p.formatPoints);
+		templ.hasReferences[p.lang] = p.hasReferences;
+		templ.flattened[p.lang].reset();
+	}
+
+	for (auto const& [templateIndex, lang] : referrers)
+		_templates[templateIndex].flattened[lang].reset();
+
+	// Unlike `markModified()`, kept flattened translations stay valid.
+	_frozen = false;
+	++_version;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+StringBuilder<NumSupportedLanguages, CharType, Allocator>& StringBuilder<NumSupportedLanguages, CharType, Allocator>::operator=(StringBuilder const& other_)
+{
+	using Traits = std::allocator_traits<Allocator>;
+
+	if (this == &other_)
+		return *this;
+
+	if constexpr (Traits::propagate_on_container_copy_assignment::value && !Traits::is_always_equal::value)
+	{
+		if (_allocator != other_._allocator)
+		{
+			// Every container has to be recreated with the other allocator. The copy is made first,
+			// so that this builder stays intact if copying throws; moving it in does not throw.
+			StringBuilder copy(other_, other_._allocator);
+			auto const version = _version;
+
+			this->~StringBuilder();
+			::new (static_cast<void*>(this)) StringBuilder(std::move(copy));
+
+			_version = version + 1;
+			return *this;
+		}
+	}
+
+	// Allocators are equal or not propagated, the builder keeps its own storage.
+	this->clear();
+	this->copyFrom(other_);
+	return *this;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+StringBuilder<NumSupportedLanguages, CharType, Allocator>& StringBuilder<NumSupportedLanguages, CharType, Allocator>::operator=(StringBuilder&& other_) noexcept(
+		std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value
+		|| std::allocator_traits<Allocator>::is_always_equal::value
+	)
 {
-	auto[it, added] = _tokenNames.insert( std::move(name_) );
+	using Traits = std::allocator_traits<Allocator>;
+
+	if (this == &other_)
+		return *this;
 
-	_constants[StringViewType(*it)] = std::move(value_);
+	if constexpr (!Traits::propagate_on_container_move_assignment::value && !Traits::is_always_equal::value)
+	{
+		if (_allocator != other_._allocator)
+		{
+			// Token names would be moved element by element, which invalidates every view to them.
+			this->clear();
+			this->copyFrom(other_);
+			++other_._version;
+			return *this;
+		}
+	}
+	else if constexpr (Traits::propagate_on_container_move_assignment::value)
+	{
+		_allocator = std::move(other_._allocator);
+	}
+
+	_templates 			= std::move(other_._templates);
+	_tokenNames 		= std::move(other_._tokenNames);
+	_constants 			= std::move(other_._constants);
+	_fallbackLanguage 	= other_._fallbackLanguage;
+	_frozen 			= other_._frozen;
+	_flattenedValid 	= other_._flattenedValid;
+	++_version;
+	++other_._version;
+	return *this;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilder<NumSupportedLanguages, CharType, Allocator>::StringViewType // return type
+	StringBuilder<NumSupportedLanguages, CharType, Allocator>::internTokenName(StringViewType tokenName_)
+{
+	auto it = _tokenNames.find(tokenName_);
+	if (it == _tokenNames.end())
+		it = _tokenNames.emplace(tokenName_).first;
+
+	return *it;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::copyFrom(StringBuilder const& other_)
+{
+	_fallbackLanguage 	= other_._fallbackLanguage;
+	_frozen 			= other_._frozen;
+	_flattenedValid 	= other_._flattenedValid;
+
+	auto const copyFormatPoints = [this](auto& formatPoints_, auto const& otherFormatPoints_) {
+			formatPoints_.reserve(otherFormatPoints_.size());
+			for (auto const& token : otherFormatPoints_)
+				formatPoints_.push_back({ token.first, this->internTokenName(token.second) });
+		};
+
+	for (auto const& tokenName : other_._tokenNames)
+		_tokenNames.emplace_hint(_tokenNames.end(), tokenName);
+
+	for (auto const& [name, value] : other_._constants)
+		_constants.emplace_hint(_constants.end(), this->internTokenName(name), StringType(value, _allocator));
+
+	_templates.reserve(other_._templates.size());
+	for (auto const& otherTempl : other_._templates)
+	{
+		auto& templ = _templates.emplace_back(_allocator);
+
+		for (std::size_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			if (!otherTempl.hasTranslation(lang))
+				continue;
+
+			templ.formatBase[lang].emplace(otherTempl.formatBase[lang].value(), _allocator);
+			copyFormatPoints(templ.formatPoints[lang], otherTempl.formatPoints[lang]);
+			templ.hasReferences[lang] = otherTempl.hasReferences[lang];
+
+			if (auto const& otherFlat = otherTempl.flattened[lang])
+			{
+				auto& flat = templ.flattened[lang].emplace( typename LocStringTemplate::FlatTranslation{
+						StringType(otherFlat->formatBase, _allocator),
+						VectorType<FormatPoint>(_allocator),
+						otherFlat->acyclic
+					} );
+				copyFormatPoints(flat.formatPoints, otherFlat->formatPoints);
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilder<NumSupportedLanguages, CharType, Allocator>::clear()
+{
+	_templates.clear();
+	_constants.clear();
+	_tokenNames.clear();
+	this->markModified();
 }
 
 
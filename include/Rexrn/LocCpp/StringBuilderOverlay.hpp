@@ -0,0 +1,284 @@
+#pragma once
+
+#include <Rexrn/LocCpp/StringBuilder.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <type_traits>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Builder of localized strings layered on a shared, immutable base builder.
+///		Stores only the translations and constants it overrides.
+/// </summary>
+/// <remarks>
+///		Translation is looked up in the requested language first (overlay, then base), then in the fallback language
+/// 	of the base (overlay, then base). Every template index maps to its overriding entry through a flat slot table,
+/// 	so a lookup costs the same as in `StringBuilder`.
+///
+/// 	Overridden constants apply to translations of the overlay only: translations of the base were prepared with
+/// 	base constants. Template references are resolved through the layers. Translations flattened by a frozen base
+/// 	are used unless they refer (directly or not) to an overridden template; those are resolved while rendering.
+/// 	Use `flatten()` to get a standalone, frozen builder for frequently used overlays.
+///
+/// 	Like `StringBuilder`, const methods may be called concurrently.
+/// </remarks>
+template <std::uint16_t NumSupportedLanguages, typename CharType = char, typename Allocator = std::allocator<CharType>>
+class StringBuilderOverlay
+{
+public:
+	using BuilderType 		= StringBuilder<NumSupportedLanguages, CharType, Allocator>;
+	using BasePtr 			= std::shared_ptr<BuilderType const>;
+	using StringType 		= typename BuilderType::StringType;
+	using StringViewType 	= typename BuilderType::StringViewType;
+	using FormatVariables 	= typename BuilderType::FormatVariables;
+	using MemoryUsageType 	= typename BuilderType::MemoryUsageType;
+
+	/// <summary>
+	///		Creates overlay which does not override anything yet.
+	/// </summary>
+	/// <param name="base_">The base builder (must not be null). It must not be modified while the overlay exists.</param>
+	explicit StringBuilderOverlay(BasePtr base_);
+
+	/// <summary>
+	///		Creates a copy of another overlay, layered on the same base.
+	/// </summary>
+	/// <param name="other_">The overlay to copy</param>
+	StringBuilderOverlay(StringBuilderOverlay const& other_) = default;
+
+	/// <summary>
+	///		Replaces content with a copy of another overlay.
+	/// </summary>
+	/// <param name="other_">The overlay to copy</param>
+	StringBuilderOverlay& operator=(StringBuilderOverlay const& other_) = default;
+
+	/// <summary>
+	///		Moves another overlay.
+	/// </summary>
+	/// <param name="other_">The overlay to move</param>
+	StringBuilderOverlay(StringBuilderOverlay&& other_) = default;
+
+	/// <summary>
+	///		Replaces content with content of another overlay.
+	/// </summary>
+	/// <param name="other_">The overlay to move</param>
+	StringBuilderOverlay& operator=(StringBuilderOverlay&& other_) = default;
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType operator()(LanguageType lang_, IndexType templateIndex_, FormatVariables const& formatVariables_ = {}) const
+	{
+		return this->build(lang_, templateIndex_, formatVariables_);
+	}
+
+	/// <summary>
+	///		Generates localized string in specified language, built from specified template.
+	/// </summary>
+	/// <param name="lang_">Language of the localized string (integer or Enum type)</param>
+	/// <param name="templateIndex_">Index of the string template (integer or Enum type)</param>
+	/// <param name="formatVariables_">Map (token name, value) used when substituting variable values for token names</param>
+	/// <returns>Generated string. Empty string if template does not exist.</returns>
+	template <typename LanguageType, typename IndexType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	StringType build(LanguageType lang_, IndexType templateIndex_, FormatVariables const& formatVariables_ = {}) const
+	{
+		return this->render( static_cast<std::uint16_t>(lang_), static_cast<std::size_t>(templateIndex_), formatVariables_ );
+	}
+
+	/// <summary>
+	///		Overrides translation of specified template in specified language.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template (integer or Enum type)</param>
+	/// <param name="lang_">The language (integer or Enum type)</param>
+	/// <param name="translation_">The translation</param>
+	template <typename IndexType, typename LanguageType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	void setTemplateTranslation(IndexType templateIndex_, LanguageType lang_, StringType translation_)
+	{
+		this->setOverride( static_cast<std::size_t>(templateIndex_), static_cast<std::uint16_t>(lang_), std::move(translation_) );
+	}
+
+	/// <summary>
+	///		Removes override of specified translation, so that the base translation is used again.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template (integer or Enum type)</param>
+	/// <param name="lang_">The language (integer or Enum type)</param>
+	template <typename IndexType, typename LanguageType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	void removeTemplateTranslation(IndexType templateIndex_, LanguageType lang_)
+	{
+		this->removeOverride( static_cast<std::size_t>(templateIndex_), static_cast<std::uint16_t>(lang_) );
+	}
+
+	/// <summary>
+	///		Determines whether specified template has translation in specified language, in any layer.
+	/// </summary>
+	/// <param name="templateIndex_">Index of the template (integer or Enum type)</param>
+	/// <param name="lang_">The language (integer or Enum type)</param>
+	/// <returns>
+	///		Boolean.
+	/// </returns>
+	template <typename IndexType, typename LanguageType,
+		typename = std::enable_if_t< detail::isIndex<LanguageType> && detail::isIndex<IndexType> > >
+	bool templateHasTranslation(IndexType templateIndex_, LanguageType lang_) const
+	{
+		return this->findInLayers( static_cast<std::size_t>(templateIndex_), static_cast<std::uint16_t>(lang_) ).has_value();
+	}
+
+	/// <summary>
+	///		Overrides constant for translations set through the overlay afterwards.
+	/// </summary>
+	/// <param name="name_">Name of the constant</param>
+	/// <param name="value_">Value of the constant</param>
+	void setConstant(StringType name_, StringType value_) {
+		_overrides.setConstant(std::move(name_), std::move(value_));
+	}
+
+	/// <returns>
+	///		Number of overridden (template, language) translations.
+	/// </returns>
+	std::size_t getNumOverrides() const;
+
+	/// <returns>
+	///		The base builder.
+	/// </returns>
+	BasePtr const& getBase() const {
+		return _base;
+	}
+
+	/// <summary>
+	///		Creates standalone builder: a copy of the base with overridden constants and translations applied, frozen.
+	/// </summary>
+	/// <returns>The builder.</returns>
+	BuilderType flatten() const;
+
+	/// <summary>
+	///		Computes memory used by the overlay itself (not by the base).
+	/// </summary>
+	/// <param name="allocationOverhead_">Estimated allocator bookkeeping per allocation</param>
+	/// <returns>The report. Slot table and index of base references are accounted as a part of `templateTable`.</returns>
+	MemoryUsageType memoryUsage(std::size_t allocationOverhead_ = BuilderType::DefaultAllocationOverhead) const;
+
+private:
+	using ReferenceStack 		= typename BuilderType::ReferenceStack;
+	using ResolvedTranslation 	= typename BuilderType::ResolvedTranslation;
+
+	/// <summary>
+	///		Marks template index that is not overridden.
+	/// </summary>
+	static constexpr std::uint32_t NoSlot = std::numeric_limits<std::uint32_t>::max();
+
+	/// <summary>
+	///		Translation found in one of the layers.
+	/// </summary>
+	struct LayerTranslation
+	{
+		/// <summary>
+		///		Builder containing the translation.
+		/// </summary>
+		BuilderType const* 	layer;
+
+		/// <summary>
+		///		Index of the template inside `layer` (slot for overrides, template index for the base).
+		/// </summary>
+		std::size_t 		index;
+
+		std::uint16_t 		lang;
+	};
+
+	/// <summary>
+	///		Finds translation in exactly specified language, overlay first.
+	/// </summary>
+	std::optional<LayerTranslation> findInLayers(std::size_t templateIndex_, std::uint16_t lang_) const;
+
+	/// <summary>
+	///		Finds translation used when specified template is requested in specified language.
+	/// </summary>
+	std::optional<LayerTranslation> resolve(std::size_t templateIndex_, std::uint16_t lang_) const;
+
+	/// <summary>
+	///		Generates localized string.
+	/// </summary>
+	StringType render(std::uint16_t lang_, std::size_t templateIndex_, FormatVariables const& formatVariables_) const;
+
+	void setOverride(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_);
+
+	void removeOverride(std::size_t templateIndex_, std::uint16_t lang_);
+
+	/// <summary>
+	///		Determines whether template has overriding translation in any language.
+	/// </summary>
+	bool isOverridden(std::size_t templateIndex_) const;
+
+	/// <summary>
+	///		Determines whether translations of base template refer (directly or not) to an overridden template,
+	///		so that they cannot be rendered from translations flattened by the base.
+	/// </summary>
+	bool dependsOnOverrides(std::size_t templateIndex_) const {
+		return std::binary_search(_dependents.begin(), _dependents.end(), templateIndex_);
+	}
+
+	/// <summary>
+	///		Adds base templates referring (directly or not) to specified template to `_dependents`.
+	///		Called when the template becomes overridden.
+	/// </summary>
+	void addDependents(std::size_t templateIndex_);
+
+	/// <summary>
+	///		Recomputes `_dependents`. Called when a template stops being overridden.
+	/// </summary>
+	void updateDependents();
+
+	/// <summary>
+	///		Walks references of the base backwards, marking every template referring to a pending one.
+	/// </summary>
+	/// <param name="pending_">Templates to start from, consumed</param>
+	/// <param name="dependent_">Marks of referring templates, indexed by template index of the base</param>
+	void markReferrers(typename BuilderType::template VectorType<std::size_t>& pending_, typename BuilderType::template VectorType<bool>& dependent_);
+
+	/// <returns>
+	///		Slot of overriding template. `NoSlot` if template is not overridden.
+	/// </returns>
+	std::uint32_t slotOf(std::size_t templateIndex_) const {
+		return templateIndex_ < _slots.size() ? _slots[templateIndex_] : NoSlot;
+	}
+
+	BasePtr 		_base;
+
+	/// <summary>
+	///		Overriding translations, stored at slots (not at template indices) so that the overlay stays small.
+	///		Uses constants of the base unless overridden.
+	/// </summary>
+	BuilderType 	_overrides;
+
+	/// <summary>
+	///		Map (template index -> slot in `_overrides`).
+	/// </summary>
+	typename BuilderType::template VectorType<std::uint32_t> 	_slots;
+
+	/// <summary>
+	///		Sorted indices of base templates referring (directly or not) to an overridden template.
+	/// </summary>
+	typename BuilderType::template VectorType<std::size_t> 		_dependents;
+
+	/// <summary>
+	///		Sorted (referenced template, referring template) pairs of the base. The base is immutable,
+	/// 	so they are collected once, when a template is overridden for the first time.
+	/// </summary>
+	typename BuilderType::template VectorType< std::pair<std::size_t, std::size_t> > 	_baseReferrers;
+	bool 																				_baseReferrersIndexed = false;
+};
+
+} // namespace rexrn::loc
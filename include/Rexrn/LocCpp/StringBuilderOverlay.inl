@@ -0,0 +1,314 @@
+#pragma once
+
+#include <Rexrn/LocCpp/StringBuilderOverlay.hpp>
+#include <Rexrn/LocCpp/StringBuilder.inl>
+
+namespace rexrn::loc
+{
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::StringBuilderOverlay(BasePtr base_)
+	: _base(std::move(base_)),
+	_overrides(_base->getAllocator()),
+	_slots(_base->getAllocator()),
+	_dependents(_base->getAllocator()),
+	_baseReferrers(_base->getAllocator())
+{
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+std::size_t StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::getNumOverrides() const
+{
+	std::size_t numOverrides = 0;
+	for (auto const& templ : _overrides._templates)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+			numOverrides += templ.hasTranslation(lang) ? 1 : 0;
+	}
+
+	return numOverrides;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::BuilderType // return type
+	StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::flatten() const
+{
+	BuilderType result(*_base, _base->getAllocator());
+	auto const allocator = result.getAllocator();
+
+	for (auto const& [name, value] : _overrides._constants)
+		result.setConstant(StringType(name, allocator), StringType(value, allocator));
+
+	for (std::size_t i = 0; i < _slots.size(); ++i)
+	{
+		if (_slots[i] == NoSlot)
+			continue;
+
+		// Translations are already prepared, only token names have to be re-pointed to the result's storage.
+		auto const& overriding = _overrides._templates[_slots[i]];
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			if (!overriding.hasTranslation(lang))
+				continue;
+
+			result.ensureTemplateExists(i);
+			auto& templ = result._templates[i];
+			templ.resetTranslation(lang);
+
+			templ.formatBase[lang].emplace(overriding.formatBase[lang].value(), allocator);
+			templ.formatPoints[lang].reserve(overriding.formatPoints[lang].size());
+			for (auto const& token : overriding.formatPoints[lang])
+				templ.formatPoints[lang].push_back({ token.first, result.internTokenName(token.second) });
+			templ.hasReferences[lang] = overriding.hasReferences[lang];
+		}
+	}
+
+	result.markModified();
+	result.freeze();
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::MemoryUsageType // return type
+	StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::memoryUsage(std::size_t allocationOverhead_) const
+{
+	auto usage = _overrides.memoryUsage(allocationOverhead_);
+
+	MemoryBlock slots;
+	detail::accountVector(slots, _slots, allocationOverhead_);
+	detail::accountVector(slots, _dependents, allocationOverhead_);
+	detail::accountVector(slots, _baseReferrers, allocationOverhead_);
+	usage.templateTable += slots;
+	usage.total 		+= slots;
+
+	return usage;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+auto StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::findInLayers(std::size_t templateIndex_, std::uint16_t lang_) const
+	-> std::optional<LayerTranslation>
+{
+	if (lang_ >= NumSupportedLanguages)
+		return std::nullopt;
+
+	auto const slot = this->slotOf(templateIndex_);
+	if (slot != NoSlot && _overrides._templates[slot].hasTranslation(lang_))
+		return LayerTranslation{ &_overrides, slot, lang_ };
+
+	if (_base->templateHasTranslation(templateIndex_, lang_))
+		return LayerTranslation{ _base.get(), templateIndex_, lang_ };
+
+	return std::nullopt;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+auto StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::resolve(std::size_t templateIndex_, std::uint16_t lang_) const
+	-> std::optional<LayerTranslation>
+{
+	if (auto translation = this->findInLayers(templateIndex_, lang_))
+		return translation;
+
+	return this->findInLayers(templateIndex_, _base->getFallbackLanguage());
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+typename StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::StringType // return type
+	StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::render(std::uint16_t lang_, std::size_t templateIndex_, FormatVariables const& formatVariables_) const
+{
+	StringType result(_base->getResultAllocator());
+
+	auto const translation = this->resolve(templateIndex_, lang_);
+	if (!translation.has_value())
+		return result;
+
+	auto const& templ = translation->layer->_templates[translation->index];
+	if (templ.hasReferences[translation->lang])
+	{
+		// Base translations flattened by the base are valid unless they refer to an overridden template.
+		bool const flattenedByBase = (translation->layer == _base.get() && _base->isFrozen() && !this->dependsOnOverrides(templateIndex_));
+		if (!flattenedByBase)
+		{
+			auto const resolveInLayers = [this](std::size_t refIndex_, std::uint16_t refLang_) -> std::optional<ResolvedTranslation>
+				{
+					auto const refTranslation = this->resolve(refIndex_, refLang_);
+					if (!refTranslation.has_value())
+						return std::nullopt;
+
+					return ResolvedTranslation{ &refTranslation->layer->_templates[refTranslation->index], refTranslation->lang };
+				};
+
+			ReferenceStack stack(_base->getResultAllocator());
+			BuilderType::appendWithReferences(result, templateIndex_, { &templ, translation->lang }, formatVariables_, stack, resolveInLayers);
+			return result;
+		}
+	}
+
+	renderTranslation(result, translation->layer->getTranslationView(translation->index, translation->lang), formatVariables_);
+
+	return result;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::setOverride(std::size_t templateIndex_, std::uint16_t lang_, StringType translation_)
+{
+	if (lang_ >= NumSupportedLanguages)
+		return;
+
+	if (_slots.size() <= templateIndex_)
+		_slots.resize(templateIndex_ + 1, NoSlot);
+
+	auto slot = _slots[templateIndex_];
+	if (slot == NoSlot)
+		slot = static_cast<std::uint32_t>(_overrides.getNumTemplates());
+
+	bool const wasOverridden = this->isOverridden(templateIndex_);
+
+	// Tokens which are not constants of the overlay are looked up in constants of the base.
+	_overrides.assignTranslation(std::size_t{ slot }, lang_, std::move(translation_), &_base->_constants);
+
+	// Slot is stored only once its template exists, so that a failed assignment never leaves a dangling slot.
+	_slots[templateIndex_] = slot;
+
+	if (!wasOverridden)
+		this->addDependents(templateIndex_);
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::removeOverride(std::size_t templateIndex_, std::uint16_t lang_)
+{
+	auto const slot = this->slotOf(templateIndex_);
+	if (slot == NoSlot || lang_ >= NumSupportedLanguages)
+		return;
+
+	// Slot is kept, it is reused if the template is overridden again.
+	_overrides.removeTemplateTranslation(std::size_t{ slot }, lang_);
+
+	if (!this->isOverridden(templateIndex_))
+		this->updateDependents();
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+bool StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::isOverridden(std::size_t templateIndex_) const
+{
+	auto const slot = this->slotOf(templateIndex_);
+	if (slot == NoSlot)
+		return false;
+
+	auto const& templ = _overrides._templates[slot];
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		if (templ.hasTranslation(lang))
+			return true;
+	}
+
+	return false;
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::addDependents(std::size_t templateIndex_)
+{
+	auto const scratchAllocator = _base->getResultAllocator();
+
+	typename BuilderType::template VectorType<std::size_t> pending(1, templateIndex_, scratchAllocator);
+	typename BuilderType::template VectorType<bool> dependent(_base->getNumTemplates(), false, scratchAllocator);
+
+	// Templates referring to current dependents are dependents already, the walk stops at them.
+	for (auto const index : _dependents)
+		dependent[index] = true;
+
+	this->markReferrers(pending, dependent);
+
+	std::size_t const numDependents = _dependents.size();
+	for (std::size_t i = 0; i < dependent.size(); ++i)
+	{
+		if (dependent[i] && !this->dependsOnOverrides(i))
+			_dependents.push_back(i);
+	}
+	std::inplace_merge(_dependents.begin(), _dependents.begin() + numDependents, _dependents.end());
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::updateDependents()
+{
+	auto const scratchAllocator = _base->getResultAllocator();
+
+	typename BuilderType::template VectorType<std::size_t> pending(scratchAllocator);
+	for (std::size_t i = 0; i < _slots.size(); ++i)
+	{
+		if (this->isOverridden(i))
+			pending.push_back(i);
+	}
+
+	typename BuilderType::template VectorType<bool> dependent(_base->getNumTemplates(), false, scratchAllocator);
+	this->markReferrers(pending, dependent);
+
+	_dependents.clear();
+	for (std::size_t i = 0; i < dependent.size(); ++i)
+	{
+		if (dependent[i])
+			_dependents.push_back(i);
+	}
+	_dependents.shrink_to_fit();
+}
+
+//////////////////////////////////////////////////////////////
+template <std::uint16_t NumSupportedLanguages, typename CharType, typename Allocator>
+void StringBuilderOverlay<NumSupportedLanguages, CharType, Allocator>::markReferrers(typename BuilderType::template VectorType<std::size_t>& pending_,
+		typename BuilderType::template VectorType<bool>& dependent_)
+{
+	if (pending_.empty())
+		return;
+
+	if (!_baseReferrersIndexed)
+	{
+		auto const& templates = _base->_templates;
+		for (std::size_t i = 0; i < templates.size(); ++i)
+		{
+			for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+			{
+				if (!templates[i].hasReferences[lang])
+					continue;
+
+				for (auto const& token : templates[i].formatPoints[lang])
+				{
+					if (auto refIndex = BuilderType::referencedTemplate(token.second))
+						_baseReferrers.emplace_back(*refIndex, i);
+				}
+			}
+		}
+		std::sort(_baseReferrers.begin(), _baseReferrers.end());
+		_baseReferrers.erase(std::unique(_baseReferrers.begin(), _baseReferrers.end()), _baseReferrers.end());
+		_baseReferrers.shrink_to_fit();
+		_baseReferrersIndexed = true;
+	}
+
+	while (!pending_.empty())
+	{
+		std::size_t const templateIndex = pending_.back();
+		pending_.pop_back();
+
+		auto it = std::lower_bound(_baseReferrers.begin(), _baseReferrers.end(), std::make_pair(templateIndex, std::size_t{ 0 }));
+		for (; it != _baseReferrers.end() && it->first == templateIndex; ++it)
+		{
+			if (dependent_[it->second])
+				continue;
+
+			dependent_[it->second] = true;
+			pending_.push_back(it->second);
+		}
+	}
+}
+
+} // namespace rexrn::loc
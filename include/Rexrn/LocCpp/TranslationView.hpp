@@ -0,0 +1,133 @@
+#pragma once
+
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <cstdint>
+
+namespace rexrn::loc
+{
+
+/// <summary>
+///		Read-only view of a prepared (render-ready) translation.
+/// </summary>
+/// <remarks>
+///		Views are produced by `StringBuilder::getTranslationView` and stored in constexpr tables generated by `CatalogCodegen`,
+///		both are rendered by the same routine (`renderTranslation`).
+/// </remarks>
+template <typename CharType = char>
+struct TranslationView
+{
+	using StringViewType 	= std::basic_string_view<CharType>;
+
+	/// <summary>
+	///		Pair describing where to insert (first, index in base format string) and what token (second).
+	/// </summary>
+	using FormatPoint 		= std::pair<std::size_t, StringViewType>;
+
+	/// <summary>
+	///		Base format string.
+	/// </summary>
+	StringViewType 		formatBase;
+
+	/// <summary>
+	///		Format points, sorted by position.
+	/// </summary>
+	FormatPoint const* 	formatPoints 	= nullptr;
+
+	/// <summary>
+	///		Number of format points.
+	/// </summary>
+	std::size_t 		numFormatPoints = 0;
+
+	/// <summary>
+	///		Determines whether translation exists.
+	/// </summary>
+	bool 				translated 		= false;
+};
+
+namespace detail
+{
+
+/// <summary>
+///		Determines whether map can be searched with key of type `KeyType` (without conversion to its own key type).
+/// </summary>
+template <typename MapType, typename KeyType, typename = void>
+constexpr bool hasLookupBy = false;
+
+template <typename MapType, typename KeyType>
+constexpr bool hasLookupBy< MapType, KeyType, std::void_t< decltype(std::declval<MapType const&>().find(std::declval<KeyType const&>())) > > = true;
+
+/// <summary>
+///		Finds variable with specified token name.
+/// </summary>
+/// <param name="formatVariables_">Map (token name, value)</param>
+/// <param name="name_">The token name</param>
+/// <returns>Iterator of the map (`end()` if not found).</returns>
+/// <remarks>
+///		Maps without heterogeneous lookup (e.g. `std::map<std::string, std::string>`) are searched with a temporary key.
+/// </remarks>
+template <typename FormatVariables, typename CharType>
+auto findVariable(FormatVariables const& formatVariables_, std::basic_string_view<CharType> name_)
+{
+	if constexpr (hasLookupBy< FormatVariables, std::basic_string_view<CharType> >)
+		return formatVariables_.find(name_);
+	else
+		return formatVariables_.find(typename FormatVariables::key_type(name_));
+}
+
+}
+
+/// <summary>
+///		Appends translation with format points substituted by values to the result.
+/// </summary>
+/// <param name="result_">String to append to</param>
+/// <param name="translation_">The translation</param>
+/// <param name="valueOf_">Function returning value (string view) of format point with specified index</param>
+template <typename StringType, typename CharType, typename ValueFunc>
+void renderTranslationWith(StringType& result_, TranslationView<CharType> const& translation_, ValueFunc&& valueOf_)
+{
+	// Compute exact length first, so that the result is allocated only once.
+	// This matters with arena allocators, which never reclaim memory of discarded buffers.
+	std::size_t length = result_.size() + translation_.formatBase.size();
+	for (std::size_t i = 0; i < translation_.numFormatPoints; ++i)
+		length += valueOf_(i).size();
+
+	result_.reserve(length);
+
+	std::size_t basePos = 0;
+	for (std::size_t i = 0; i < translation_.numFormatPoints; ++i)
+	{
+		std::size_t const position = translation_.formatPoints[i].first;
+
+		result_.append(translation_.formatBase.substr(basePos, position - basePos));
+		result_.append(valueOf_(i));
+		basePos = position;
+	}
+	result_.append(translation_.formatBase.substr(basePos));
+}
+
+/// <summary>
+///		Appends translation with token names substituted by variable values to the result.
+/// </summary>
+/// <param name="result_">String to append to</param>
+/// <param name="translation_">The translation</param>
+/// <param name="formatVariables_">Map (token name, value), preferably supporting lookup by string view</param>
+/// <remarks>
+///		Tokens without value are substituted by their names.
+/// </remarks>
+template <typename StringType, typename CharType, typename FormatVariables>
+void renderTranslation(StringType& result_, TranslationView<CharType> const& translation_, FormatVariables const& formatVariables_)
+{
+	using StringViewType = std::basic_string_view<CharType>;
+
+	// Lookup is heterogeneous, so no temporary string is created.
+	renderTranslationWith(result_, translation_, [&](std::size_t pointIndex_) {
+			auto const& token = translation_.formatPoints[pointIndex_];
+
+			auto itVarName = detail::findVariable(formatVariables_, token.second);
+			return (itVarName != formatVariables_.end()) ? StringViewType(itVarName->second) : token.second;
+		});
+}
+
+} // namespace rexrn::loc
\ No newline at end of file
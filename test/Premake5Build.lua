@@ -1,37 +1,54 @@
-project "UnitTests"
-	kind "ConsoleApp"
-	language "C++"
-	cppdialect "C++17"
+-- Settings shared by every test executable.
+local function testProject(name)
+	project (name)
+		kind "ConsoleApp"
+		language "C++"
+		cppdialect "C++17"
 
-	location (path.join(repoRoot, "build/%{prj.name}"))
-	targetdir (path.join(repoRoot, "bin/%{cfg.platform}/%{cfg.buildcfg}"))
+		location (path.join(repoRoot, "build/%{prj.name}"))
+		targetdir (path.join(repoRoot, "bin/%{cfg.platform}/%{cfg.buildcfg}"))
 
-	includedirs {
-		-- Rexrn::LocCpp
-		path.join(repoRoot, "include"),
+		includedirs {
+			-- Rexrn::LocCpp
+			path.join(repoRoot, "include"),
 
-		-- Google Test
-		path.join(userConfig.deps.gtest.root, "include")
-	}
-
-	-- Link Google Test
-	
-	filter "configurations:Debug"
-		links {
-			path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtestd"),
-			path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest_maind")
+			-- Google Test
+			path.join(userConfig.deps.gtest.root, "include")
 		}
+
+		-- Link Google Test
 		
+		filter "configurations:Debug"
+			links {
+				path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtestd"),
+				path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest_maind")
+			}
+			
 
-	filter "configurations:Release"
-		links {
-			path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest"),
-			path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest_main")
-		}
+		filter "configurations:Release"
+			links {
+				path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest"),
+				path.join(userConfig.deps.gtest.root, "lib/%{cfg.platform}/%{cfg.buildcfg}/gtest_main")
+			}
+
+		filter {}
+end
 
-	filter {}
+testProject "UnitTests"
+	defines {
+		-- Catalog files used by tests
+		'LOCCPP_TEST_DATA_DIR="' .. path.join(repoRoot, "test/data") .. '"'
+	}
 
 	files {
 		-- Current project:
 		"src/**.cpp"
-	}
\ No newline at end of file
+	}
+
+-- Replaces global operator new/delete to count allocations, so it cannot share
+-- the executable with other tests (nor be built with sanitizers replacing them).
+testProject "AllocationTests"
+	files {
+		-- Current project:
+		"allocation/**.cpp"
+	}
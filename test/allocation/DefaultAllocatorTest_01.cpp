@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Global allocation functions are replaced to count allocations made by the whole program,
+// which is why these tests are built as a separate executable (AllocationTests).
+namespace
+{
+
+std::atomic<std::size_t> g_numAllocations{ 0 };
+
+void* countedAllocate(std::size_t size_)
+{
+	g_numAllocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* ptr = std::malloc(size_ == 0 ? 1 : size_))
+		return ptr;
+
+	throw std::bad_alloc{};
+}
+
+}
+
+void* operator new(std::size_t size_) {
+	return countedAllocate(size_);
+}
+
+void* operator new[](std::size_t size_) {
+	return countedAllocate(size_);
+}
+
+void operator delete(void* ptr_) noexcept {
+	std::free(ptr_);
+}
+
+void operator delete[](void* ptr_) noexcept {
+	std::free(ptr_);
+}
+
+void operator delete(void* ptr_, std::size_t) noexcept {
+	std::free(ptr_);
+}
+
+void operator delete[](void* ptr_, std::size_t) noexcept {
+	std::free(ptr_);
+}
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+enum class Message {
+	Player = 0,
+	Greeting = 1,
+	Farewell = 2
+};
+
+// Default allocator, exactly as shown in the README:
+using Builder = rexrn::loc::StringBuilder<NumSupportedLanguages>;
+using Context = rexrn::loc::RenderContext<char>;
+
+/// <summary>
+///		Fills builder with templates: plain, with references and untranslated (fallback).
+/// </summary>
+void fillCatalog(Builder& builder_)
+{
+	builder_.setConstant("COLOR_RED", "{FF0000FF}");
+	builder_.setTemplate(Message::Player, { "gracz $(COLOR_RED)$(PersonName)", "player $(COLOR_RED)$(PersonName)" });
+	builder_.setTemplate(Message::Greeting, { "Witaj, $(@0)! Masz $(Count) wiadomosci.", "Hello, $(@0)! You have $(Count) messages." });
+	builder_.setTemplateTranslation(Message::Farewell, Language::Polish, "Do widzenia, $(PersonName)!");
+}
+
+/// <summary>
+///		Renders every template in every language with varying variables.
+/// </summary>
+/// <returns>Total length of generated strings.</returns>
+std::size_t renderAll(Builder const& builder_, Context& context_)
+{
+	std::size_t length = 0;
+	for (int i = 0; i < 100; ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			for (std::size_t templateIndex = 0; templateIndex < 4; ++templateIndex)
+			{
+				context_.reset()
+					.set("PersonName", (i % 2) ? "PoetaKodu" : "Administrator of the server")
+					.set("Count", i * 1000);
+
+				length += builder_.build(context_, lang, templateIndex).size();
+			}
+		}
+	}
+	return length;
+}
+
+}
+
+TEST(LocCpp, RenderContext_DefaultAllocator_NoAllocationsWhenWarm)
+{
+	static_assert(std::is_same_v<Builder::RenderContextType, Context>);
+
+	Builder builder;
+	fillCatalog(builder);
+
+	auto& context = Context::threadLocal();
+
+	// Not frozen (references rendered recursively), then frozen:
+	for (bool frozen : { false, true })
+	{
+		if (frozen)
+			builder.freeze();
+
+		// Warm up, so that every buffer reaches its final capacity:
+		std::size_t const expectedLength = renderAll(builder, context);
+
+		std::size_t const numAllocationsBefore = g_numAllocations.load();
+		std::size_t const length = renderAll(builder, context);
+		std::size_t const numAllocations = g_numAllocations.load() - numAllocationsBefore;
+
+		EXPECT_EQ(length, expectedLength);
+		EXPECT_EQ(numAllocations, 0u) << (frozen ? "frozen" : "not frozen");
+	}
+
+	// Allocations are counted at all:
+	std::size_t const numAllocationsBefore = g_numAllocations.load();
+	auto const result = builder.build(Language::English, Message::Greeting, { { "PersonName", "Administrator of the server" } });
+	EXPECT_GT(g_numAllocations.load(), numAllocationsBefore);
+}
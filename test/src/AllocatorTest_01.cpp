@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include "TestHelpers.hpp"
+
+#include <memory_resource>
+
+namespace
+{
+
+using loc_test::CountingResource;
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+}
+
+TEST(LocCpp, PmrCatalogStorage)
+{
+	using namespace rexrn;
+
+	CountingResource catalogResource;
+
+	loc::pmr::StringBuilder<NumSupportedLanguages> builder(&catalogResource);
+	builder.setConstant("COLOR_RED", "{FF0000FF}");
+	builder.setTemplate(0, {
+			"Witaj, $(COLOR_RED)$(PersonName)! Milego dnia i do zobaczenia.",
+			"Hello, $(COLOR_RED)$(PersonName)! Have a nice day and see you."
+		});
+
+	// Token table, constants, templates and their format points live in the catalog resource:
+	EXPECT_GT(catalogResource.numAllocations, 0u);
+	EXPECT_EQ(builder.getAllocator().resource(), &catalogResource);
+
+	// Rendering does not touch the catalog resource (it would grow arenas and race on unsynchronized pools):
+	std::size_t const numCatalogAllocations = catalogResource.numAllocations;
+
+	auto const english = builder.build(Language::English, 0, { { "PersonName", "PoetaKodu" } });
+	EXPECT_EQ(english, "Hello, {FF0000FF}PoetaKodu! Have a nice day and see you.");
+	EXPECT_EQ(english.get_allocator().resource(), std::pmr::get_default_resource());
+
+	auto const handle = builder.bind(Language::English, 0);
+	EXPECT_EQ(handle({ "PoetaKodu" }), english);
+
+	EXPECT_EQ(catalogResource.numAllocations, numCatalogAllocations);
+}
+
+TEST(LocCpp, PmrPerRequestResult)
+{
+	using namespace rexrn;
+
+	loc::pmr::StringBuilder<NumSupportedLanguages> builder;
+	builder.setTemplate(0, {
+			"Witaj, $(PersonName)! Milego dnia i do zobaczenia wkrotce.",
+			"Hello, $(PersonName)! Have a nice day and see you soon."
+		});
+
+	std::array<std::byte, 1024> buffer;
+	std::pmr::monotonic_buffer_resource requestArena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+	using Builder = decltype(builder);
+	Builder::FormatVariables variables(&requestArena);
+	variables.emplace("PersonName", "PoetaKodu");
+
+	// Both variables and result are placed inside the (non-growing) request arena:
+	auto const polish = builder.build(0, 0, variables, &requestArena);
+	EXPECT_EQ(polish, "Witaj, PoetaKodu! Milego dnia i do zobaczenia wkrotce.");
+	EXPECT_EQ(polish.get_allocator().resource(), &requestArena);
+}
+
+namespace
+{
+
+/// <summary>
+///		Stateful allocator propagated on copy assignment.
+/// </summary>
+template <typename T>
+struct TaggedAllocator
+{
+	using value_type = T;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using is_always_equal = std::false_type;
+
+	int tag = 0;
+
+	TaggedAllocator() = default;
+	explicit TaggedAllocator(int tag_) : tag(tag_) {}
+	template <typename U>
+	TaggedAllocator(TaggedAllocator<U> const& other_) : tag(other_.tag) {}
+
+	T* allocate(std::size_t n_) { return std::allocator<T>().allocate(n_); }
+	void deallocate(T* ptr_, std::size_t n_) { std::allocator<T>().deallocate(ptr_, n_); }
+
+	template <typename U>
+	bool operator==(TaggedAllocator<U> const& other_) const { return tag == other_.tag; }
+	template <typename U>
+	bool operator!=(TaggedAllocator<U> const& other_) const { return tag != other_.tag; }
+};
+
+}
+
+TEST(LocCpp, CopyAssignmentPropagatesAllocator)
+{
+	using namespace rexrn;
+
+	using Builder = loc::StringBuilder<NumSupportedLanguages, char, TaggedAllocator<char>>;
+
+	Builder source{ TaggedAllocator<char>(1) };
+	source.setTemplate(0, { "Witaj, $(Name)!", "Hello, $(Name)!" });
+
+	Builder target{ TaggedAllocator<char>(2) };
+	target.setTemplate(0, { "Stare", "Old" });
+	auto const bound = target.bind(1, 0);
+	EXPECT_TRUE(bound.isValid());
+
+	target = source;
+	EXPECT_EQ(target.getAllocator().tag, 1);
+	EXPECT_FALSE(bound.isValid());
+
+	Builder::FormatVariables variables{ TaggedAllocator<char>(3) };
+	variables.emplace("Name", "PoetaKodu");
+	EXPECT_EQ(target.build(1, 0, variables, TaggedAllocator<char>(3)), "Hello, PoetaKodu!");
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+// Prepare localized text index:
+enum class LocTextIndex {
+	Score,
+	Greeting,
+	Welcome
+};
+
+// Moving the builder (e.g. when a vector of builders grows) never throws:
+static_assert(std::is_nothrow_move_constructible_v< rexrn::loc::StringBuilder<NumSupportedLanguages> >);
+static_assert(std::is_nothrow_move_assignable_v< rexrn::loc::StringBuilder<NumSupportedLanguages> >);
+static_assert(std::is_nothrow_move_constructible_v< rexrn::loc::pmr::StringBuilder<NumSupportedLanguages> >);
+
+}
+
+TEST(LocCpp, BoundTemplate)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setFallbackLanguage(Language::Polish);
+	builder.setTemplate(LocTextIndex::Score, { "Wynik $(PlayerName): $(Score) ($(PlayerName))", "$(PlayerName) score: $(Score) ($(PlayerName))" });
+	builder.setTemplateTranslation(LocTextIndex::Greeting, Language::Polish, "Witaj, $(PlayerName)!");
+
+	auto const score = builder.bind(Language::English, LocTextIndex::Score);
+	ASSERT_TRUE(score.isValid());
+
+	// Slots are distinct token names in order of appearance:
+	ASSERT_EQ(score.getNumSlots(), 2u);
+	EXPECT_EQ(score.getSlotName(0), "PlayerName");
+	EXPECT_EQ(score.getSlotName(1), "Score");
+	EXPECT_EQ(score.findSlot("Score"), 1u);
+	EXPECT_FALSE(score.findSlot("Unknown").has_value());
+
+	EXPECT_EQ(score({ "PoetaKodu", "100" }), "PoetaKodu score: 100 (PoetaKodu)");
+	EXPECT_EQ(score({ { "PlayerName", "PoetaKodu" }, { "Score", "100" } }), "PoetaKodu score: 100 (PoetaKodu)");
+	// Missing slot value is substituted by token name, like in `build`:
+	EXPECT_EQ(score({ "PoetaKodu" }), "PoetaKodu score: Score (PoetaKodu)");
+
+	// Reusing one buffer:
+	std::string buffer = "> ";
+	std::string_view const arguments[] = { "PoetaKodu", "100" };
+	EXPECT_TRUE(score.appendTo(buffer, arguments, 2));
+	EXPECT_EQ(buffer, "> PoetaKodu score: 100 (PoetaKodu)");
+
+	// Fallback is resolved when binding:
+	auto const greeting = builder.bind(Language::English, LocTextIndex::Greeting);
+	EXPECT_EQ(greeting({ "PoetaKodu" }), "Witaj, PoetaKodu!");
+
+	// Missing template:
+	EXPECT_FALSE(builder.bind(Language::English, LocTextIndex::Welcome).isValid());
+	EXPECT_EQ(builder.bind(Language::English, LocTextIndex::Welcome)({ "PoetaKodu" }), "");
+
+	// Any modification invalidates handles:
+	builder.setTemplateTranslation(LocTextIndex::Greeting, Language::English, "Hello, $(PlayerName)!");
+	EXPECT_FALSE(score.isValid());
+	EXPECT_FALSE(greeting.isValid());
+	EXPECT_EQ(score({ "PoetaKodu", "100" }), "");
+
+	EXPECT_EQ(builder.bind(Language::English, LocTextIndex::Greeting)({ "PoetaKodu" }), "Hello, PoetaKodu!");
+}
+
+TEST(LocCpp, BoundTemplateWithReferences)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setTemplate(LocTextIndex::Score, { "$(Score) pkt", "$(Score) pts" });
+	builder.setTemplate(LocTextIndex::Greeting, { "Witaj, $(PlayerName)! $(@0)", "Hello, $(PlayerName)! $(@0)" });
+
+	// References must be flattened first:
+	EXPECT_FALSE(builder.bind(Language::English, LocTextIndex::Greeting).isValid());
+
+	builder.freeze();
+	auto const greeting = builder.bind(Language::English, LocTextIndex::Greeting);
+	ASSERT_TRUE(greeting.isValid());
+	ASSERT_EQ(greeting.getNumSlots(), 2u);
+	EXPECT_EQ(greeting({ "PoetaKodu", "100" }), "Hello, PoetaKodu! 100 pts");
+
+	// Freezing an unchanged builder keeps bound handles valid:
+	EXPECT_TRUE(builder.freeze());
+	EXPECT_TRUE(greeting.isValid());
+	EXPECT_EQ(greeting({ "PoetaKodu", "100" }), "Hello, PoetaKodu! 100 pts");
+
+	// Updates make the next freeze replace flattened translations:
+	builder.setTemplate(LocTextIndex::Score, { "$(Score) pkt", "$(Score) points" });
+	builder.freeze();
+	EXPECT_FALSE(greeting.isValid());
+
+	// Moving the builder invalidates handles bound to the moved-from one:
+	auto moved = std::move(builder);
+	EXPECT_FALSE(greeting.isValid());
+	EXPECT_TRUE(moved.bind(Language::English, LocTextIndex::Greeting).isValid());
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+/// <summary>
+///		Replaces content of specified file.
+/// </summary>
+void writeFile(std::filesystem::path const& path_, char const* content_)
+{
+	std::ofstream file(path_, std::ios::out | std::ios::trunc | std::ios::binary);
+	file << content_;
+}
+
+/// <summary>
+///		Temporary directory removed at the end of the test.
+/// </summary>
+struct TemporaryDirectory
+{
+	std::filesystem::path path;
+
+	TemporaryDirectory()
+		: path( std::filesystem::temp_directory_path() / ("LocCppTest_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name()) )
+	{
+		std::filesystem::create_directories(path);
+	}
+
+	~TemporaryDirectory() {
+		std::error_code ec;
+		std::filesystem::remove_all(path, ec);
+	}
+};
+
+}
+
+TEST(LocCpp, CatalogParsing)
+{
+	using namespace rexrn;
+
+	auto const result = loc::parseCatalog<char>(
+			"# Comment\n"
+			"0 = Hello, $(PersonName)!\r\n"
+			"\n"
+			"  12\t=\\sTwo\\nlines\\\\  \n"
+			"invalid line\n"
+			"COLOR_RED = {FF0000FF}"
+		);
+
+	ASSERT_EQ(result.entries.size(), 3u);
+	EXPECT_EQ(result.entries[0].key, "0");
+	EXPECT_EQ(result.entries[0].value, "Hello, $(PersonName)!");
+	EXPECT_EQ(result.entries[1].key, "12");
+	EXPECT_EQ(result.entries[1].value, " Two\nlines\\");
+	EXPECT_EQ(result.entries[1].line, 4u);
+	EXPECT_EQ(result.entries[2].key, "COLOR_RED");
+
+	ASSERT_EQ(result.invalidLines.size(), 1u);
+	EXPECT_EQ(result.invalidLines[0], 5u);
+
+	EXPECT_EQ(loc::parseTemplateIndex<char>("12"), 12u);
+	EXPECT_FALSE(loc::parseTemplateIndex<char>("COLOR_RED").has_value());
+
+	std::vector< loc::CatalogEntry<char> const* > ignored;
+	auto const translations = loc::collectTranslations(result.entries, &ignored);
+	ASSERT_EQ(translations.size(), 2u);
+	EXPECT_EQ(translations[0].first, 0u);
+	EXPECT_EQ(translations[0].second, "Hello, $(PersonName)!");
+	EXPECT_EQ(translations[1].first, 12u);
+	ASSERT_EQ(ignored.size(), 1u);
+	EXPECT_EQ(ignored[0], &result.entries[2]);
+
+	// Template index above the limit is reported as invalid line:
+	std::vector<std::size_t> invalidLines;
+	auto const limited = loc::collectTranslations<char>(result.entries, nullptr, &invalidLines, 10);
+	ASSERT_EQ(limited.size(), 1u);
+	EXPECT_EQ(limited[0].first, 0u);
+	ASSERT_EQ(invalidLines.size(), 1u);
+	EXPECT_EQ(invalidLines[0], 4u);
+}
+
+TEST(LocCpp, CatalogHotReload)
+{
+	using namespace rexrn;
+	using Builder = loc::StringBuilder<NumSupportedLanguages>;
+
+	TemporaryDirectory directory;
+	auto const polishPath 	= directory.path / "pl.cat";
+	auto const englishPath 	= directory.path / "en.cat";
+
+	writeFile(polishPath, "0 = Witaj, $(COLOR_RED)$(PersonName)!\n1 = Do widzenia!\n");
+	writeFile(englishPath, "0 = Hello, $(COLOR_RED)$(PersonName)!\n1 = Goodbye!\n");
+
+	Builder initial;
+	initial.setConstant("COLOR_RED", "{FF0000FF}");
+
+	loc::CatalogLoader<Builder> loader(std::move(initial));
+	ASSERT_TRUE(loader.addFile(polishPath, 0));
+	ASSERT_TRUE(loader.addFile(englishPath, 1));
+
+	auto const before = loader.catalog();
+	EXPECT_EQ(before->build(Language::English, 0, { { "PersonName", "PoetaKodu" } }), "Hello, {FF0000FF}PoetaKodu!");
+
+	// Nothing changed:
+	EXPECT_EQ(loader.poll(), 0u);
+	EXPECT_EQ(loader.catalog(), before);
+
+	// Change one translation and remove other:
+	writeFile(englishPath, "0 = Hi, $(COLOR_RED)$(PersonName)!\n");
+
+	// File systems without inotify compare modification time, make sure it differs.
+	std::filesystem::last_write_time(englishPath, std::filesystem::last_write_time(englishPath) + std::chrono::seconds(1));
+
+	EXPECT_EQ(loader.poll(), 2u);
+
+	auto const after = loader.catalog();
+	EXPECT_EQ(after->build(Language::English, 0, { { "PersonName", "PoetaKodu" } }), "Hi, {FF0000FF}PoetaKodu!");
+	EXPECT_FALSE(after->templateHasTranslation(1, Language::English));
+	EXPECT_EQ(after->build(Language::Polish, 1), "Do widzenia!");
+
+	// Previous snapshot is untouched:
+	EXPECT_EQ(before->build(Language::English, 0, { { "PersonName", "PoetaKodu" } }), "Hello, {FF0000FF}PoetaKodu!");
+	EXPECT_EQ(before->build(Language::English, 1), "Goodbye!");
+}
+
+TEST(LocCpp, CopiedBuilderOwnsTokenNames)
+{
+	using namespace rexrn;
+	using Builder = loc::StringBuilder<NumSupportedLanguages>;
+
+	std::optional<Builder> original;
+	original.emplace();
+	original->setTemplate(0, { "Witaj, $(PersonName)!", "Hello, $(PersonName)!" });
+
+	Builder copy(*original);
+	original.reset();
+
+	EXPECT_EQ(copy.build(Language::English, 0, { { "PersonName", "PoetaKodu" } }), "Hello, PoetaKodu!");
+}
+
+TEST(LocCpp, CatalogLoaderRejectsHugeTemplateIndex)
+{
+	using namespace rexrn;
+	using Builder = loc::StringBuilder<NumSupportedLanguages>;
+
+	TemporaryDirectory directory;
+	auto const englishPath = directory.path / "en.cat";
+
+	// Typo in the key would otherwise allocate every template slot up to it:
+	writeFile(englishPath, "0 = Hello!\n99999999 = Oops\ninvalid line\n");
+
+	loc::CatalogLoader<Builder> loader;
+	ASSERT_TRUE(loader.addFile(englishPath, 1));
+	EXPECT_EQ(loader.catalog()->getNumTemplates(), 1u);
+	EXPECT_EQ(loader.catalog()->build(Language::English, 0), "Hello!");
+	EXPECT_EQ(loader.getInvalidLines(englishPath), (std::vector<std::size_t>{ 2, 3 }));
+
+	// The file is loaded, so polling has nothing to do:
+	EXPECT_EQ(loader.poll(), 0u);
+
+	// Fixed file is reloaded and no longer reports the line:
+	writeFile(englishPath, "0 = Hello!\n1 = Fixed\n");
+	std::filesystem::last_write_time(englishPath, std::filesystem::last_write_time(englishPath) + std::chrono::seconds(1));
+
+	EXPECT_EQ(loader.poll(), 1u);
+	EXPECT_EQ(loader.catalog()->build(Language::English, 1), "Fixed");
+	EXPECT_TRUE(loader.getInvalidLines(englishPath).empty());
+}
@@ -0,0 +1,51 @@
+// Generated by CatalogCodegen. Do not edit.
+#pragma once
+
+#include <Rexrn/LocCpp/StaticStringBuilder.hpp>
+
+namespace loc_test_catalog
+{
+
+inline constexpr std::uint16_t NumLanguages = 2;
+inline constexpr std::size_t NumTemplates = 7;
+
+inline constexpr rexrn::loc::TranslationView<char>::FormatPoint FormatPoints[] = {
+	{ 16, std::string_view("PersonName", 10) },
+	{ 17, std::string_view("PersonName", 10) },
+	{ 23, std::string_view("PersonName", 10) },
+	{ 24, std::string_view("PersonName", 10) },
+	{ 45, std::string_view("Count", 5) },
+	{ 13, std::string_view("PersonName", 10) },
+	{ 32, std::string_view("PersonName", 10) },
+	{ 25, std::string_view("Unknown", 7) },
+	{ 0, std::string_view("@5", 2) },
+	{ 0, std::string_view("@6", 2) },
+};
+
+inline constexpr rexrn::loc::TranslationView<char> Translations[] = {
+	// Template 0:
+	{ std::string_view("gracz {FF0000FF}{FFFFFFFF}", 26), FormatPoints + 0, 1, true },
+	{ std::string_view("player {FF0000FF}{FFFFFFFF}", 27), FormatPoints + 1, 1, true },
+	// Template 1:
+	{ std::string_view("Witaj, gracz {FF0000FF}{FFFFFFFF}!", 34), FormatPoints + 2, 1, true },
+	{ std::string_view("Hello, player {FF0000FF}{FFFFFFFF}! You have  new messages.", 59), FormatPoints + 3, 2, true },
+	// Template 2:
+	{ std::string_view("Do widzenia, !", 14), FormatPoints + 5, 1, true },
+	{},
+	// Template 3:
+	{},
+	{ std::string_view(" Leading space and Do widzenia, !", 33), FormatPoints + 6, 1, true },
+	// Template 4:
+	{ std::string_view("\305\273\303\263\305\202w: \"cudzys\305\202\303\263w\" \\ \nNowa linia", 36), FormatPoints + 7, 1, true },
+	{},
+	// Template 5:
+	{ std::string_view("", 0), FormatPoints + 8, 1, true },
+	{},
+	// Template 6:
+	{ std::string_view("", 0), FormatPoints + 9, 1, true },
+	{},
+};
+
+inline constexpr rexrn::loc::StaticStringBuilder<NumLanguages> Catalog{ Translations, NumTemplates, 0 };
+
+} // namespace loc_test_catalog
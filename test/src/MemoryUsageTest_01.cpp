@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+}
+
+TEST(LocCpp, MemoryUsage)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+
+	auto const empty = builder.memoryUsage();
+	EXPECT_EQ(empty.total.bytes, 0u);
+	EXPECT_EQ(empty.total.numAllocations, 0u);
+
+	std::string const longText(200, 'x');
+
+	builder.setConstant("COLOR_RED", "{FF0000FF} and some text long enough to be allocated");
+	builder.setTemplateTranslation(0, Language::Polish, "$(PersonName): " + longText);
+	builder.setTemplateTranslation(1, Language::Polish, longText);
+	// Same content again:
+	builder.setTemplateTranslation(3, Language::Polish, longText);
+
+	auto const usage = builder.memoryUsage(16);
+
+	// English is not translated at all:
+	EXPECT_GT(usage.languages[0].bytes, 3 * longText.size());
+	EXPECT_EQ(usage.languages[1].bytes, 0u);
+
+	// Templates are another breakdown of languages, template 2 is only a slot in the table:
+	ASSERT_EQ(usage.templates.size(), 4u);
+	EXPECT_GT(usage.templates[0].bytes, longText.size());
+	EXPECT_EQ(usage.templates[2].bytes, 0u);
+	EXPECT_EQ(usage.templates[0].bytes + usage.templates[1].bytes + usage.templates[3].bytes, usage.languages[0].bytes);
+
+	EXPECT_GE(usage.tokenNames.numAllocations, 2u); // "COLOR_RED", "PersonName" nodes
+	EXPECT_GT(usage.constants.bytes, 0u);
+	EXPECT_GT(usage.templateTable.bytes, 0u);
+
+	EXPECT_EQ(usage.numDuplicatedStrings, 1u);
+	EXPECT_EQ(usage.duplicatedStringBytes, longText.size());
+
+	// Total is the sum of parts:
+	loc::MemoryBlock sum = usage.templateTable;
+	sum += usage.languages[0];
+	sum += usage.languages[1];
+	sum += usage.tokenNames;
+	sum += usage.constants;
+	EXPECT_EQ(usage.total.bytes, sum.bytes);
+	EXPECT_EQ(usage.total.wastedBytes, sum.wastedBytes);
+	EXPECT_EQ(usage.total.numAllocations, sum.numAllocations);
+	EXPECT_EQ(usage.total.overheadBytes, 16 * sum.numAllocations);
+	EXPECT_EQ(usage.total.totalBytes(), sum.bytes + sum.overheadBytes);
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include "TestHelpers.hpp"
+
+#include <filesystem>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	Spanish = 2,
+	German = 3,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+enum class Message {
+	Greeting = 0,
+	Farewell = 1
+};
+
+using PagedBuilder = rexrn::loc::PagedStringBuilder<NumSupportedLanguages>;
+
+/// <summary>
+///		In-memory catalog source counting how many times every language was loaded.
+/// </summary>
+struct CountingSource
+{
+	std::array<std::size_t, NumSupportedLanguages> numLoads{};
+
+	PagedBuilder::CatalogSource source()
+	{
+		return [this](std::uint16_t lang_) -> std::optional<PagedBuilder::CatalogPage>
+			{
+				++numLoads[lang_];
+				switch(static_cast<Language>(lang_))
+				{
+				case Language::Polish: 	return PagedBuilder::CatalogPage{ { 0, "Witaj, $(PersonName)!" }, { 1, "Do widzenia!" } };
+				case Language::English: return PagedBuilder::CatalogPage{ { 0, "Hello, $(PersonName)! " + std::string(200, 'e') } };
+				case Language::Spanish: return PagedBuilder::CatalogPage{ { 0, "Hola, $(PersonName)! " + std::string(200, 's') } };
+				default: 				return std::nullopt;
+				}
+			};
+	}
+};
+
+}
+
+TEST(LocCpp, PagedStringBuilder_LoadsOnDemand)
+{
+	CountingSource counter;
+	PagedBuilder builder(counter.source(), 1024 * 1024);
+
+	// Only the fallback language is loaded up front:
+	EXPECT_TRUE(builder.isResident(0));
+	EXPECT_FALSE(builder.isResident(1));
+	EXPECT_EQ(counter.numLoads[0], 1u);
+	EXPECT_EQ(counter.numLoads[1], 0u);
+
+	EXPECT_EQ(builder.build(Language::English, Message::Greeting, { { "PersonName", "PoetaKodu" } }).substr(0, 18), "Hello, PoetaKodu! ");
+	EXPECT_TRUE(builder.isResident(1));
+
+	// Resident language is not loaded again, missing translations fall back:
+	EXPECT_EQ(builder(Language::English, Message::Farewell), "Do widzenia!");
+	EXPECT_EQ(counter.numLoads[1], 1u);
+
+	// Language that cannot be loaded falls back and is not requested on every render:
+	EXPECT_EQ(builder.build(Language::German, Message::Greeting, { { "PersonName", "PoetaKodu" } }), "Witaj, PoetaKodu!");
+	EXPECT_EQ(builder.build(Language::German, Message::Farewell), "Do widzenia!");
+	EXPECT_EQ(counter.numLoads[3], 1u);
+
+	// Unloading lets it be retried:
+	EXPECT_FALSE(builder.load(3));
+	builder.unload(3);
+	EXPECT_FALSE(builder.load(3));
+	EXPECT_EQ(counter.numLoads[3], 2u);
+}
+
+TEST(LocCpp, PagedStringBuilder_EvictsLeastRecentlyUsed)
+{
+	CountingSource counter;
+	PagedBuilder builder(counter.source(), 1024 * 1024);
+
+	auto const polishBytes = builder.getResidentBytes();
+	EXPECT_GT(polishBytes, 0u);
+
+	builder.build(Language::English, Message::Greeting);
+	builder.build(Language::Spanish, Message::Greeting);
+	ASSERT_TRUE(builder.isResident(1));
+	ASSERT_TRUE(builder.isResident(2));
+
+	// Room for the fallback language and a single other language only:
+	std::size_t const oneLanguage = (builder.getResidentBytes() - polishBytes) / 2;
+	builder.setMemoryBudget(polishBytes + oneLanguage);
+
+	// English was used least recently:
+	EXPECT_FALSE(builder.isResident(1));
+	EXPECT_TRUE(builder.isResident(2));
+	EXPECT_FALSE(builder.getBuilder().templateHasTranslation(0, Language::English));
+	EXPECT_LE(builder.getResidentBytes(), builder.getMemoryBudget());
+
+	// Loading English again evicts Spanish, the fallback language stays:
+	EXPECT_EQ(builder.build(Language::English, Message::Greeting, { { "PersonName", "PoetaKodu" } }).substr(0, 18), "Hello, PoetaKodu! ");
+	EXPECT_EQ(counter.numLoads[1], 2u);
+	EXPECT_TRUE(builder.isResident(0));
+	EXPECT_TRUE(builder.isResident(1));
+	EXPECT_FALSE(builder.isResident(2));
+
+	// Fallback language is never evicted, even with no budget at all; the language in use is kept too:
+	builder.setMemoryBudget(0);
+	EXPECT_TRUE(builder.isResident(0));
+	EXPECT_TRUE(builder.isResident(1));
+
+	builder.unload(0);
+	EXPECT_TRUE(builder.isResident(0));
+	EXPECT_EQ(builder.build(Language::Spanish, Message::Farewell), "Do widzenia!");
+	EXPECT_FALSE(builder.isResident(1));
+	EXPECT_EQ(counter.numLoads[0], 1u);
+}
+
+TEST(LocCpp, PagedStringBuilder_ReferencesAcrossPages)
+{
+	PagedBuilder builder([](std::uint16_t lang_) -> std::optional<PagedBuilder::CatalogPage>
+		{
+			switch(static_cast<Language>(lang_))
+			{
+			case Language::Polish: 	return PagedBuilder::CatalogPage{ { 0, "Witaj, $(PersonName)!" }, { 1, "$(@0) Do widzenia!" } };
+			case Language::English: return PagedBuilder::CatalogPage{ { 0, "Hello, $(PersonName)!" }, { 2, "$(@1) Bye!" } };
+			default: 				return PagedBuilder::CatalogPage{};
+			}
+		}, 1024 * 1024);
+
+	auto const checkSizes = [&]() {
+			auto const usage = builder.getBuilder().memoryUsage();
+
+			std::size_t residentBytes = 0;
+			for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+				residentBytes += builder.isResident(lang) ? usage.languages[lang].totalBytes() : 0;
+
+			EXPECT_TRUE(builder.getBuilder().isFrozen());
+			EXPECT_EQ(builder.getResidentBytes(), residentBytes);
+		};
+
+	checkSizes();
+
+	// Reference resolved in English falls back to Polish for untranslated template:
+	EXPECT_EQ(builder.build(Language::English, 2, { { "PersonName", "n" } }), "Witaj, n! Do widzenia! Bye!");
+	checkSizes();
+
+	EXPECT_EQ(builder.build(Language::Spanish, 1, { { "PersonName", "n" } }), "Witaj, n! Do widzenia!");
+	checkSizes();
+
+	// Unloading keeps other languages flattened:
+	builder.unload(1);
+	checkSizes();
+	EXPECT_EQ(builder.build(Language::Spanish, 2), "");
+	EXPECT_EQ(builder.build(Language::English, 1, { { "PersonName", "n" } }), "Witaj, n! Do widzenia!");
+	checkSizes();
+}
+
+TEST(LocCpp, PagedStringBuilder_CatalogFiles)
+{
+	using namespace rexrn;
+
+	auto const directory = std::filesystem::path(LOCCPP_TEST_DATA_DIR) / "StaticCatalog";
+
+	loc::StringBuilder<NumSupportedLanguages> base;
+	base.setConstant("COLOR_RED", "{FF0000FF}");
+	base.setConstant("COLOR_WHITE", "{FFFFFFFF}");
+	base.setFallbackLanguage(Language::Polish);
+
+	PagedBuilder builder(
+			PagedBuilder::catalogFiles({ directory / "Polish.cat", directory / "English.cat", {}, directory / "Missing.cat" }),
+			1024 * 1024, std::move(base)
+		);
+
+	// References are flattened across pages (English template 1 refers to English template 0):
+	EXPECT_EQ(builder.build(Language::English, 1, { { "PersonName", "PoetaKodu" }, { "Count", "5" } }),
+		"Hello, player {FF0000FF}PoetaKodu{FFFFFFFF}! You have 5 new messages.");
+	EXPECT_TRUE(builder.getBuilder().isFrozen());
+
+	// Empty path means no translations, missing file could not be loaded:
+	EXPECT_TRUE(builder.load(2));
+	EXPECT_FALSE(builder.load(3));
+	EXPECT_EQ(builder.build(Language::Spanish, 2, { { "PersonName", "PoetaKodu" } }), "Do widzenia, PoetaKodu!");
+}
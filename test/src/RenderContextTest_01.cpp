@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include "TestHelpers.hpp"
+
+#include <memory_resource>
+
+namespace
+{
+
+using loc_test::CountingResource;
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+enum class Message {
+	Player = 0,
+	Greeting = 1,
+	Farewell = 2
+};
+
+using Builder = rexrn::loc::pmr::StringBuilder<NumSupportedLanguages>;
+using Context = Builder::RenderContextType;
+
+/// <summary>
+///		Determines whether `RenderContext::set` accepts value of specified type.
+/// </summary>
+template <typename T, typename = void>
+constexpr bool canSetValue = false;
+
+template <typename T>
+constexpr bool canSetValue< T, std::void_t< decltype(std::declval<Context&>().set("Name", std::declval<T>())) > > = true;
+
+// Numbers and strings, but not characters nor booleans (which would be printed as numbers):
+static_assert(canSetValue<int> && canSetValue<std::uint8_t> && canSetValue<std::size_t> && canSetValue<char const*>);
+static_assert(!canSetValue<char> && !canSetValue<wchar_t> && !canSetValue<char32_t> && !canSetValue<bool>);
+
+/// <summary>
+///		Fills builder with templates: plain, with references and untranslated (fallback).
+/// </summary>
+void fillCatalog(Builder& builder_)
+{
+	builder_.setConstant("COLOR_RED", "{FF0000FF}");
+	builder_.setTemplate(Message::Player, { "gracz $(COLOR_RED)$(PersonName)", "player $(COLOR_RED)$(PersonName)" });
+	builder_.setTemplate(Message::Greeting, { "Witaj, $(@0)! Masz $(Count) wiadomosci.", "Hello, $(@0)! You have $(Count) messages." });
+	builder_.setTemplateTranslation(Message::Farewell, Language::Polish, "Do widzenia, $(PersonName)!");
+}
+
+/// <summary>
+///		Renders every template in every language with varying variables.
+/// </summary>
+/// <returns>Total length of generated strings.</returns>
+std::size_t renderAll(Builder const& builder_, Context& context_)
+{
+	std::size_t length = 0;
+	for (int i = 0; i < 100; ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			for (std::size_t templateIndex = 0; templateIndex < 4; ++templateIndex)
+			{
+				context_.reset()
+					.set("PersonName", (i % 2) ? "PoetaKodu" : "Administrator of the server")
+					.set("Count", i * 1000);
+
+				length += builder_.build(context_, lang, templateIndex).size();
+			}
+		}
+	}
+	return length;
+}
+
+}
+
+TEST(LocCpp, RenderContext_SameResults)
+{
+	Builder builder;
+	fillCatalog(builder);
+
+	auto& context = Context::threadLocal();
+	EXPECT_EQ(&context, &Context::threadLocal());
+
+	for (bool frozen : { false, true })
+	{
+		if (frozen)
+			builder.freeze();
+
+		context.reset().set("PersonName", "PoetaKodu").set("Count", -12);
+		EXPECT_EQ(builder.build(context, Language::English, Message::Greeting), "Hello, player {FF0000FF}PoetaKodu! You have -12 messages.");
+		EXPECT_EQ(context.getOutput(), "Hello, player {FF0000FF}PoetaKodu! You have -12 messages.");
+
+		// Variable set again replaces the value:
+		context.set("PersonName", "Admin");
+		EXPECT_EQ(context.getVariables().size(), 2u);
+		EXPECT_EQ(builder.build(context, 1, Message::Farewell), "Do widzenia, Admin!");
+
+		// Same results as with the map of variables:
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			for (std::size_t templateIndex = 0; templateIndex < 4; ++templateIndex)
+			{
+				EXPECT_EQ(builder.build(context, lang, templateIndex),
+					builder.build(lang, templateIndex, { { "PersonName", "Admin" }, { "Count", "-12" } }));
+			}
+		}
+	}
+
+	// Missing template:
+	context.reset();
+	EXPECT_TRUE(builder.build(context, Language::Polish, 100).empty());
+}
+
+TEST(LocCpp, RenderContext_NoAllocationsWhenWarm)
+{
+	// Catalog, context buffers and anything the builder allocates while rendering (default resource) are counted:
+	CountingResource resource;
+	std::pmr::memory_resource* const previousDefault = std::pmr::set_default_resource(&resource);
+
+	Builder builder(&resource);
+	fillCatalog(builder);
+
+	Context context(&resource);
+
+	// Not frozen (references rendered recursively), then frozen:
+	for (bool frozen : { false, true })
+	{
+		if (frozen)
+			builder.freeze();
+
+		// Warm up, so that every buffer reaches its final capacity:
+		std::size_t const expectedLength = renderAll(builder, context);
+
+		std::size_t const numAllocationsBefore = resource.numAllocations;
+		std::size_t const length = renderAll(builder, context);
+		std::size_t const numAllocations = resource.numAllocations - numAllocationsBefore;
+
+		EXPECT_EQ(length, expectedLength);
+		EXPECT_EQ(numAllocations, 0u) << (frozen ? "frozen" : "not frozen");
+	}
+
+	// Allocations are counted at all:
+	std::size_t const numAllocationsBefore = resource.numAllocations;
+	auto const result = builder.build(Language::English, Message::Greeting, { { "PersonName", "Administrator of the server" } });
+	EXPECT_GT(resource.numAllocations, numAllocationsBefore);
+
+	std::pmr::set_default_resource(previousDefault);
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+// Generated from test/data/StaticCatalog (run from the test directory):
+//   CatalogCodegen --namespace loc_test_catalog --fallback 0 --constants data/StaticCatalog/Constants.cat
+//     --output src/Generated/StaticCatalog.hpp data/StaticCatalog/Polish.cat data/StaticCatalog/English.cat
+#include "Generated/StaticCatalog.hpp"
+#include "TestHelpers.hpp"
+
+#include <filesystem>
+#include <memory_resource>
+
+namespace
+{
+
+using loc_test::CountingResource;
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+static_assert(loc_test_catalog::NumLanguages == NumSupportedLanguages);
+
+// Table is usable in constant expressions:
+static_assert(loc_test_catalog::Catalog.templateHasTranslation(0, Language::English));
+static_assert(!loc_test_catalog::Catalog.templateHasTranslation(2, Language::English));
+
+/// <summary>
+///		Loads catalog files into runtime builder, exactly like the generator does.
+/// </summary>
+void loadCatalog(rexrn::loc::StringBuilder<NumSupportedLanguages>& builder_)
+{
+	using namespace rexrn;
+
+	auto const directory = std::filesystem::path(LOCCPP_TEST_DATA_DIR) / "StaticCatalog";
+
+	builder_.setFallbackLanguage(Language::Polish);
+
+	auto constants = loc::readCatalogFile(directory / "Constants.cat");
+	ASSERT_TRUE(constants.has_value());
+	for (auto& entry : loc::parseCatalog<char>(*constants).entries)
+		builder_.setConstant(entry.key, entry.value);
+
+	char const* files[NumSupportedLanguages] = { "Polish.cat", "English.cat" };
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		auto content = loc::readCatalogFile(directory / files[lang]);
+		ASSERT_TRUE(content.has_value());
+		for (auto& entry : loc::parseCatalog<char>(*content).entries)
+			builder_.setTemplateTranslation(loc::parseTemplateIndex<char>(entry.key).value(), lang, entry.value);
+	}
+
+	builder_.freeze();
+}
+
+}
+
+TEST(LocCpp, StaticBuilderMatchesRuntimeBuilder)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	loadCatalog(builder);
+
+	auto const& catalog = loc_test_catalog::Catalog;
+	ASSERT_EQ(catalog.getNumTemplates(), builder.getNumTemplates());
+
+	loc::StringBuilder<NumSupportedLanguages>::FormatVariables const variableSets[] = {
+			{},
+			{ { "PersonName", "PoetaKodu" } },
+			{ { "PersonName", "PoetaKodu" }, { "Count", "12" }, { "Unknown", "?" }, { "@5", "ref" } }
+		};
+
+	// One index past the end checks missing template:
+	for (std::size_t i = 0; i <= builder.getNumTemplates(); ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+		{
+			EXPECT_EQ(catalog.templateHasTranslation(i, lang), builder.templateHasTranslation(i, lang));
+
+			for (auto const& variables : variableSets)
+				EXPECT_EQ(catalog.build(lang, i, variables), builder.build(lang, i, variables)) << "template " << i << ", language " << lang;
+		}
+	}
+
+	EXPECT_EQ(catalog(Language::English, 1, { { "PersonName", "PoetaKodu" }, { "Count", "12" } }),
+		"Hello, player {FF0000FF}PoetaKodu{FFFFFFFF}! You have 12 new messages.");
+}
+
+TEST(LocCpp, StaticBuilderRendersIntoCallerBuffer)
+{
+	using namespace rexrn;
+
+	auto const& catalog = loc_test_catalog::Catalog;
+
+	decltype(loc_test_catalog::Catalog)::FormatVariables const variables = { { "PersonName", "PoetaKodu" }, { "Count", "12" } };
+
+	CountingResource resource;
+	std::pmr::string buffer(&resource);
+
+	auto const renderAll = [&]
+		{
+			std::size_t length = 0;
+			for (std::size_t i = 0; i <= catalog.getNumTemplates(); ++i)
+			{
+				for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+				{
+					buffer.clear();
+					catalog.appendTo(buffer, lang, i, variables);
+					EXPECT_EQ(std::string_view(buffer), catalog.build(lang, i, variables));
+					length += buffer.size();
+				}
+			}
+			return length;
+		};
+
+	// Warm up, so that the buffer reaches its final capacity:
+	std::size_t const expectedLength = renderAll();
+	EXPECT_GT(resource.numAllocations, 0u);
+
+	std::size_t const numAllocationsBefore = resource.numAllocations;
+	EXPECT_EQ(renderAll(), expectedLength);
+	EXPECT_EQ(resource.numAllocations, numAllocationsBefore);
+
+	// Appends to existing content:
+	buffer = "> ";
+	catalog.appendTo(buffer, Language::English, 1, variables);
+	EXPECT_EQ(std::string_view(buffer), "> Hello, player {FF0000FF}PoetaKodu{FFFFFFFF}! You have 12 new messages.");
+
+	// Render context gives the same results:
+	loc::RenderContext<char> context;
+	context.reset().set("PersonName", "PoetaKodu").set("Count", 12);
+	for (std::size_t i = 0; i <= catalog.getNumTemplates(); ++i)
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+			EXPECT_EQ(catalog.build(context, lang, i), catalog.build(lang, i, variables));
+	}
+}
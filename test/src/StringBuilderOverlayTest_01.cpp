@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include "TestHelpers.hpp"
+
+#include <memory_resource>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+enum class Message {
+	Player = 0,
+	Greeting = 1,
+	Farewell = 2
+};
+
+using Builder = rexrn::loc::StringBuilder<NumSupportedLanguages>;
+using Overlay = rexrn::loc::StringBuilderOverlay<NumSupportedLanguages>;
+
+/// <summary>
+///		Creates shared base catalog.
+/// </summary>
+std::shared_ptr<Builder const> makeBase()
+{
+	auto base = std::make_shared<Builder>();
+	base->setConstant("COLOR_RED", "{FF0000FF}");
+	base->setTemplate(Message::Player, { "gracz $(COLOR_RED)$(PersonName)", "player $(COLOR_RED)$(PersonName)" });
+	base->setTemplate(Message::Greeting, { "Witaj, $(@0)!", "Hello, $(@0)!" });
+	base->setTemplateTranslation(Message::Farewell, Language::Polish, "Do widzenia!");
+	base->freeze();
+	return base;
+}
+
+}
+
+TEST(LocCpp, StringBuilderOverlay_ResolvesThroughLayers)
+{
+	auto const base = makeBase();
+	Overlay overlay(base);
+
+	Builder::FormatVariables const vars = { { "PersonName", "PoetaKodu" } };
+
+	// Nothing overridden, base is used (references flattened by the base):
+	EXPECT_EQ(overlay.build(Language::English, Message::Greeting, vars), "Hello, player {FF0000FF}PoetaKodu!");
+	EXPECT_EQ(overlay.getNumOverrides(), 0u);
+
+	// Overlay sees constants of the base and may override them for its own translations:
+	overlay.setConstant("COLOR_BLUE", "{0000FFFF}");
+	overlay.setTemplateTranslation(Message::Player, Language::English, "hero $(COLOR_BLUE)$(PersonName)$(COLOR_RED)");
+	EXPECT_EQ(overlay(Language::English, Message::Player, vars), "hero {0000FFFF}PoetaKodu{FF0000FF}");
+
+	// References of base translations resolve to overriding translations:
+	EXPECT_EQ(overlay.build(Language::English, Message::Greeting, vars), "Hello, hero {0000FFFF}PoetaKodu{FF0000FF}!");
+	EXPECT_EQ(overlay.build(Language::Polish, Message::Greeting, vars), "Witaj, gracz {FF0000FF}PoetaKodu!");
+
+	// Requested language in any layer is preferred over the fallback language:
+	overlay.setTemplateTranslation(Message::Farewell, Language::English, "Bye!");
+	EXPECT_EQ(overlay.build(Language::English, Message::Farewell), "Bye!");
+	overlay.removeTemplateTranslation(Message::Farewell, Language::English);
+	EXPECT_EQ(overlay.build(Language::English, Message::Farewell), "Do widzenia!");
+	EXPECT_TRUE(overlay.templateHasTranslation(Message::Player, Language::English));
+	EXPECT_FALSE(overlay.templateHasTranslation(Message::Farewell, Language::English));
+
+	// Base is not affected:
+	EXPECT_EQ(base->build(Language::English, Message::Greeting, vars), "Hello, player {FF0000FF}PoetaKodu!");
+	EXPECT_EQ(overlay.getNumOverrides(), 1u);
+
+	// Overlay stores only what it overrides:
+	auto const overlayUsage = overlay.memoryUsage();
+	EXPECT_EQ(overlayUsage.templateTable.numAllocations, 4u); // slot table, templates referring to overrides, references of the base and a single overriding template
+	EXPECT_LT(overlayUsage.total.bytes, base->memoryUsage().total.bytes);
+}
+
+TEST(LocCpp, StringBuilderOverlay_Flatten)
+{
+	auto const base = makeBase();
+	Overlay overlay(base);
+
+	overlay.setTemplateTranslation(Message::Player, Language::Polish, "bohater $(PersonName)");
+	overlay.setTemplateTranslation(Message::Farewell, Language::English, "Bye, $(@0)!");
+
+	// Cyclic reference is rendered as token name, like in the base builder:
+	overlay.setTemplateTranslation(10, Language::English, "$(@10)");
+	EXPECT_EQ(overlay.build(Language::English, 10), "@10");
+
+	auto const flat = overlay.flatten();
+	EXPECT_TRUE(flat.isFrozen());
+
+	Builder::FormatVariables const vars = { { "PersonName", "PoetaKodu" } };
+	for (std::size_t templateIndex : { 0, 1, 2, 10 })
+	{
+		for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+			EXPECT_EQ(flat.build(lang, templateIndex, vars), overlay.build(lang, templateIndex, vars)) << templateIndex << ", " << lang;
+	}
+
+	EXPECT_EQ(flat.build(Language::English, Message::Farewell, vars), "Bye, player {FF0000FF}PoetaKodu!");
+	EXPECT_EQ(flat.build(Language::Polish, Message::Greeting, vars), "Witaj, bohater PoetaKodu!");
+}
+
+TEST(LocCpp, StringBuilderOverlay_IndirectReferences)
+{
+	auto base = std::make_shared<Builder>();
+	base->setTemplate(0, { "zero", "zero" });
+	base->setTemplate(1, { "one($(@0))", "one($(@0))" });
+	base->setTemplate(2, { "two($(@1))", "two($(@1))" });
+	base->setTemplate(3, { "three", "three" });
+	base->setTemplate(4, { "four($(@3))", "four($(@3))" });
+	base->freeze();
+
+	Overlay overlay(base);
+	auto const emptyUsage = overlay.memoryUsage();
+
+	// Base translation referring to an overridden template through another one:
+	overlay.setTemplateTranslation(0, Language::English, "ZERO");
+	EXPECT_EQ(overlay.build(Language::English, 2), "two(one(ZERO))");
+	EXPECT_EQ(overlay.build(Language::Polish, 2), "two(one(zero))");
+	EXPECT_EQ(overlay.build(Language::English, 4), "four(three)");
+
+	overlay.setTemplateTranslation(3, Language::Polish, "THREE");
+	EXPECT_EQ(overlay.build(Language::Polish, 4), "four(THREE)");
+
+	// Once overrides are removed, nothing refers to overridden templates anymore:
+	overlay.removeTemplateTranslation(0, Language::English);
+	overlay.removeTemplateTranslation(3, Language::Polish);
+	EXPECT_EQ(overlay.build(Language::English, 2), "two(one(zero))");
+	EXPECT_EQ(overlay.build(Language::Polish, 4), "four(three)");
+
+	auto const usage = overlay.memoryUsage();
+	EXPECT_EQ(usage.templateTable.numAllocations, emptyUsage.templateTable.numAllocations + 3); // slot table, references of the base and overriding templates
+}
+
+TEST(LocCpp, StringBuilderOverlay_FailedOverride)
+{
+	using PmrBuilder = rexrn::loc::pmr::StringBuilder<NumSupportedLanguages>;
+
+	loc_test::FailingResource resource;
+
+	auto base = std::make_shared<PmrBuilder>(&resource);
+	base->setTemplate(0, { "zero", "zero" });
+	base->setTemplate(1, { "one($(@0))", "one($(@0))" });
+	base->freeze();
+
+	rexrn::loc::StringBuilderOverlay<NumSupportedLanguages, char, PmrBuilder::AllocatorType> overlay(base);
+	overlay.setTemplateTranslation(5, Language::English, "five"); // Slot table covers template 0 already.
+
+	resource.failing = true;
+	EXPECT_THROW(overlay.setTemplateTranslation(0, Language::English, "ZERO"), std::bad_alloc);
+	resource.failing = false;
+
+	// Nothing is overridden:
+	EXPECT_EQ(overlay.getNumOverrides(), 1u);
+	EXPECT_EQ(overlay.build(Language::English, 0), "zero");
+	EXPECT_EQ(overlay.build(Language::English, 1), "one(zero)");
+
+	overlay.setTemplateTranslation(0, Language::English, "ZERO");
+	EXPECT_EQ(overlay.build(Language::English, 1), "one(ZERO)");
+}
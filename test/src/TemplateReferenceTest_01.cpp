@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+namespace
+{
+
+// Prepare language enum:
+enum class Language {
+	Polish = 0,
+	English = 1,
+	MAX
+};
+constexpr std::uint16_t NumSupportedLanguages = static_cast<std::uint16_t>(Language::MAX);
+
+// Prepare localized text index:
+enum class LocTextIndex {
+	PlayerName,
+	Greeting,
+	Welcome,
+	CycleA,
+	CycleB
+};
+
+}
+
+TEST(LocCpp, TemplateReferences)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setConstant("COLOR_RED", "{FF0000FF}");
+	builder.setFallbackLanguage(Language::English);
+
+	builder.setTemplate(LocTextIndex::PlayerName, { "gracz $(COLOR_RED)$(PersonName)", "player $(COLOR_RED)$(PersonName)" });
+	builder.setTemplate(LocTextIndex::Greeting, { "Witaj, $(@0)!", "Hello, $(@0)!" });
+	// Not translated to Polish, English (fallback) is used together with references inside it:
+	builder.setTemplateTranslation(LocTextIndex::Welcome, Language::English, "$(@1) Server: $(ServerName).");
+
+	loc::StringBuilder<NumSupportedLanguages>::FormatVariables const variables = {
+			{ "PersonName", "PoetaKodu" },
+			{ "ServerName", "LocCpp" }
+		};
+
+	auto const check = [&]() {
+			EXPECT_EQ(builder.build(Language::Polish, LocTextIndex::Greeting, variables), "Witaj, gracz {FF0000FF}PoetaKodu!");
+			EXPECT_EQ(builder.build(Language::English, LocTextIndex::Greeting, variables), "Hello, player {FF0000FF}PoetaKodu!");
+			EXPECT_EQ(builder.build(Language::Polish, LocTextIndex::Welcome, variables), "Hello, player {FF0000FF}PoetaKodu! Server: LocCpp.");
+		};
+
+	// Not frozen, rendered recursively:
+	EXPECT_FALSE(builder.isFrozen());
+	check();
+
+	// Flattened:
+	EXPECT_TRUE(builder.freeze());
+	EXPECT_TRUE(builder.isFrozen());
+	check();
+
+	// Modification unfreezes and referencing templates see the change:
+	builder.setTemplateTranslation(LocTextIndex::PlayerName, Language::Polish, "graczu $(PersonName)");
+	EXPECT_FALSE(builder.isFrozen());
+	EXPECT_EQ(builder.build(Language::Polish, LocTextIndex::Greeting, variables), "Witaj, graczu PoetaKodu!");
+
+	EXPECT_TRUE(builder.freeze());
+	EXPECT_EQ(builder.build(Language::Polish, LocTextIndex::Greeting, variables), "Witaj, graczu PoetaKodu!");
+
+	// Copy keeps flattened translations:
+	auto const copy = builder;
+	EXPECT_TRUE(copy.isFrozen());
+	EXPECT_EQ(copy.build(Language::Polish, LocTextIndex::Greeting, variables), "Witaj, graczu PoetaKodu!");
+}
+
+TEST(LocCpp, CyclicTemplateReferences)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setTemplate(LocTextIndex::CycleA, { "A($(@4))", "A($(@4))" });
+	builder.setTemplate(LocTextIndex::CycleB, { "B($(@3))", "B($(@3))" });
+	builder.setTemplate(LocTextIndex::Greeting, { "Witaj, $(@100)!", "Hello, $(@100)!" });
+
+	EXPECT_FALSE(builder.freeze());
+
+	// Cyclic reference is left unresolved:
+	EXPECT_EQ(builder.build(Language::English, LocTextIndex::CycleA), "A(B(@3))");
+
+	// Reference to missing template behaves like unknown token:
+	EXPECT_EQ(builder.build(Language::English, LocTextIndex::Greeting), "Hello, @100!");
+	EXPECT_EQ(builder.build(Language::English, LocTextIndex::Greeting, { { "@100", "world" } }), "Hello, world!");
+}
+
+TEST(LocCpp, CyclicTemplateReferences_FrozenSameAsNotFrozen)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setFallbackLanguage(Language::English);
+
+	// Cycle of two:
+	builder.setTemplate(0, { "A($(@1))", "A($(@1))" });
+	builder.setTemplate(1, { "B($(@0))", "B($(@0))" });
+	// Cycle of three, entered from outside:
+	builder.setTemplate(2, { "C($(@3))", "C($(@3))" });
+	builder.setTemplate(3, { "D($(@4) $(Name))", "D($(@4) $(Name))" });
+	builder.setTemplateTranslation(4, Language::English, "E($(@2))");
+	builder.setTemplate(5, { "X($(@3), $(@1))", "X($(@3), $(@1))" });
+
+	auto frozen = builder;
+	EXPECT_FALSE(frozen.freeze());
+
+	EXPECT_EQ(builder.build(Language::English, 0), "A(B(@0))");
+	EXPECT_EQ(builder.build(Language::English, 1), "B(A(@1))");
+	EXPECT_EQ(builder.build(Language::Polish, 4, { { "Name", "n" } }), "E(C(D(@4 n)))");
+
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		for (std::size_t templateIndex = 0; templateIndex < 6; ++templateIndex)
+		{
+			EXPECT_EQ(frozen.build(lang, templateIndex, { { "Name", "n" } }), builder.build(lang, templateIndex, { { "Name", "n" } }))
+				<< "language " << lang << ", template " << templateIndex;
+		}
+	}
+}
+
+TEST(LocCpp, TemplateReferences_FreezeAfterUpdates)
+{
+	using namespace rexrn;
+
+	using Builder = loc::StringBuilder<NumSupportedLanguages>;
+
+	Builder builder;
+	builder.setFallbackLanguage(Language::English);
+
+	builder.setTemplate(0, { "gracz $(Name)", "player $(Name)" });
+	builder.setTemplate(1, { "Witaj, $(@0)!", "Hello, $(@0)!" });
+	builder.setTemplateTranslation(2, Language::English, "$(@1) [$(@7)]");
+	builder.setTemplate(3, { "A($(@4))", "A($(@4))" });
+	builder.setTemplate(4, { "B($(@3))", "B($(@3))" });
+	builder.setTemplate(5, { "Bez odwolan", "No references" });
+	builder.setTemplate(6, { "$(@5) $(@3)", "$(@5) $(@3)" });
+	EXPECT_FALSE(builder.freeze());
+
+	// Changed leaf, fallback translation replaced by own one, template appearing under a dangling reference:
+	std::vector<Builder::TranslationUpdate> const updates = {
+			{ 0, static_cast<std::uint16_t>(Language::Polish), "graczu $(Name)" },
+			{ 1, static_cast<std::uint16_t>(Language::English), std::nullopt },
+			{ 2, static_cast<std::uint16_t>(Language::Polish), "$(@1) {$(@7)}" },
+			{ 7, static_cast<std::uint16_t>(Language::English), "nowy $(@0)" },
+		};
+	builder.applyTranslationUpdates(updates);
+	EXPECT_FALSE(builder.isFrozen());
+
+	// Flattening everything again must give the same result:
+	Builder reference = builder;
+	reference.setFallbackLanguage(Language::English);
+
+	EXPECT_FALSE(builder.freeze()); // Untouched cycle is still reported.
+	EXPECT_FALSE(reference.freeze());
+
+	for (std::uint16_t lang = 0; lang < NumSupportedLanguages; ++lang)
+	{
+		for (std::size_t templateIndex = 0; templateIndex < builder.getNumTemplates(); ++templateIndex)
+		{
+			EXPECT_EQ(builder.build(lang, templateIndex, { { "Name", "n" } }), reference.build(lang, templateIndex, { { "Name", "n" } }))
+				<< "language " << lang << ", template " << templateIndex;
+		}
+	}
+	EXPECT_EQ(builder.build(Language::Polish, 2, { { "Name", "n" } }), "Witaj, graczu n! {nowy player n}");
+
+	// Breaking the cycle is noticed too:
+	builder.applyTranslationUpdates(std::vector<Builder::TranslationUpdate>{
+			{ 4, static_cast<std::uint16_t>(Language::Polish), "B" },
+			{ 4, static_cast<std::uint16_t>(Language::English), "B" }
+		});
+	EXPECT_TRUE(builder.freeze());
+	EXPECT_EQ(builder.build(Language::English, 6), "No references A(B)");
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <filesystem>
+#include <memory_resource>
+#include <new>
+
+// Test data directory is defined by the build, otherwise it is found relatively to this file.
+#ifndef LOCCPP_TEST_DATA_DIR
+	#define LOCCPP_TEST_DATA_DIR (std::filesystem::path(__FILE__).parent_path().parent_path() / "data")
+#endif
+
+namespace loc_test
+{
+
+/// <summary>
+///		Memory resource which counts allocations forwarded to its upstream.
+/// </summary>
+class CountingResource
+	: public std::pmr::memory_resource
+{
+public:
+	std::size_t numAllocations = 0;
+
+private:
+	void* do_allocate(std::size_t bytes_, std::size_t alignment_) override {
+		++numAllocations;
+		return std::pmr::new_delete_resource()->allocate(bytes_, alignment_);
+	}
+
+	void do_deallocate(void* ptr_, std::size_t bytes_, std::size_t alignment_) override {
+		std::pmr::new_delete_resource()->deallocate(ptr_, bytes_, alignment_);
+	}
+
+	bool do_is_equal(std::pmr::memory_resource const& other_) const noexcept override {
+		return this == &other_;
+	}
+};
+
+/// <summary>
+///		Memory resource which fails every allocation while `failing` is set.
+/// </summary>
+class FailingResource
+	: public std::pmr::memory_resource
+{
+public:
+	bool failing = false;
+
+private:
+	void* do_allocate(std::size_t bytes_, std::size_t alignment_) override {
+		if (failing)
+			throw std::bad_alloc{};
+		return std::pmr::new_delete_resource()->allocate(bytes_, alignment_);
+	}
+
+	void do_deallocate(void* ptr_, std::size_t bytes_, std::size_t alignment_) override {
+		std::pmr::new_delete_resource()->deallocate(ptr_, bytes_, alignment_);
+	}
+
+	bool do_is_equal(std::pmr::memory_resource const& other_) const noexcept override {
+		return this == &other_;
+	}
+};
+
+} // namespace loc_test
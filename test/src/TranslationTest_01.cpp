@@ -2,6 +2,9 @@
 
 #include <Rexrn/LocCpp/Everything.hpp>
 
+#include <map>
+#include <unordered_map>
+
 // Prepare language enum:
 enum class Language {
 	Polish = 0,
@@ -141,4 +144,19 @@ TEST(LocCpp, FallbackSubstitution)
 		std::string const english = builder.build(Language::English, LocTextIndex::GoodbyeMessage, { {"PersonName", personName} });
 		EXPECT_EQ(english, goodbyeExpected[1]);
 	}
-}
\ No newline at end of file
+}
+TEST(LocCpp, OtherVariableMaps)
+{
+	using namespace rexrn;
+
+	loc::StringBuilder<NumSupportedLanguages> builder;
+	builder.setTemplate(LocTextIndex::HelloMessage, { "Witaj, $(PersonName)!", "Hello, $(PersonName)!" });
+
+	// Map without heterogeneous lookup:
+	std::map<std::string, std::string> variables;
+	variables["PersonName"] = "PoetaKodu";
+
+	EXPECT_EQ(builder.build(0, 0, variables), "Witaj, PoetaKodu!");
+	EXPECT_EQ(builder(Language::English, LocTextIndex::HelloMessage, variables), "Hello, PoetaKodu!");
+	EXPECT_EQ(builder.build(Language::English, 0, std::unordered_map<std::string, std::string>{ { "PersonName", "John" } }), "Hello, John!");
+}
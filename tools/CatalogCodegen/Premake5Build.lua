@@ -0,0 +1,17 @@
+project "CatalogCodegen"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	location (path.join(repoRoot, "build/%{prj.name}/tools"))
+	targetdir (path.join(repoRoot, "bin/%{cfg.platform}/%{cfg.buildcfg}/tools"))
+
+	includedirs {
+		-- Rexrn::LocCpp
+		path.join(repoRoot, "include"),
+	}
+
+	files {
+		-- Current project:
+		"src/**.cpp"
+	}
@@ -0,0 +1,312 @@
+// Generates C++ header with constexpr translation table from catalog files.
+//
+// Usage:
+//   CatalogCodegen [--namespace <name>] [--fallback <language>] [--constants <file>] --output <header> <language files...>
+//
+// Language files are given in language order (first file is language 0). Use "-" for language without translations.
+// Generated header defines (inside the namespace) `NumLanguages`, `NumTemplates`, `FormatPoints`, `Translations`
+// and `Catalog` - a `rexrn::loc::StaticStringBuilder` rendering the same results as `rexrn::loc::StringBuilder`
+// loaded with the same files.
+
+#include <Rexrn/LocCpp/Everything.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/// <summary>
+///		Upper limit of languages handled by the generator (the runtime builder needs it at compile time).
+/// </summary>
+constexpr std::uint16_t MaxLanguages = 32;
+
+using Builder = rexrn::loc::StringBuilder<MaxLanguages>;
+
+/// <summary>
+///		Command line options.
+/// </summary>
+struct Options
+{
+	std::string 				namespaceName 	= "loc_catalog";
+	std::uint16_t 				fallback 		= 0;
+	std::string 				constantsFile;
+	std::string 				outputFile;
+	std::vector<std::string> 	languageFiles;
+};
+
+/// <summary>
+///		Prints usage to standard error output.
+/// </summary>
+void printUsage()
+{
+	std::cerr << "Usage: CatalogCodegen [--namespace <name>] [--fallback <language>] [--constants <file>]"
+		" --output <header> <language files...>" << std::endl;
+}
+
+/// <summary>
+///		Parses command line options.
+/// </summary>
+/// <returns>True on success.</returns>
+bool parseOptions(int argc_, char* argv_[], Options& options_)
+{
+	for (int i = 1; i < argc_; ++i)
+	{
+		std::string const arg = argv_[i];
+
+		auto const nextValue = [&]() -> char const* {
+				return (i + 1 < argc_) ? argv_[++i] : nullptr;
+			};
+
+		if (arg == "--namespace" || arg == "--fallback" || arg == "--constants" || arg == "--output")
+		{
+			char const* value = nextValue();
+			if (!value)
+			{
+				std::cerr << "Missing value of " << arg << std::endl;
+				return false;
+			}
+
+			if (arg == "--namespace")
+				options_.namespaceName = value;
+			else if (arg == "--constants")
+				options_.constantsFile = value;
+			else if (arg == "--output")
+				options_.outputFile = value;
+			else
+			{
+				auto const fallback = rexrn::loc::parseTemplateIndex<char>(value);
+				if (!fallback.has_value() || *fallback >= MaxLanguages)
+				{
+					std::cerr << "Invalid fallback language: " << value << std::endl;
+					return false;
+				}
+				options_.fallback = static_cast<std::uint16_t>(*fallback);
+			}
+		}
+		else
+			options_.languageFiles.push_back(arg);
+	}
+
+	if (options_.outputFile.empty() || options_.languageFiles.empty())
+		return false;
+
+	if (options_.languageFiles.size() > MaxLanguages)
+	{
+		std::cerr << "At most " << MaxLanguages << " languages are supported." << std::endl;
+		return false;
+	}
+
+	if (options_.fallback >= options_.languageFiles.size())
+	{
+		std::cerr << "Fallback language " << options_.fallback << " is not one of the languages." << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+///		Reads and parses catalog file, reporting invalid lines.
+/// </summary>
+/// <returns>Parsed entries. Empty optional if file could not be read.</returns>
+std::optional< std::vector< rexrn::loc::CatalogEntry<char> > > readEntries(std::string const& path_)
+{
+	auto content = rexrn::loc::readCatalogFile(path_);
+	if (!content.has_value())
+	{
+		std::cerr << "Could not read " << path_ << std::endl;
+		return std::nullopt;
+	}
+
+	auto result = rexrn::loc::parseCatalog<char>(*content);
+	for (auto line : result.invalidLines)
+		std::cerr << path_ << ":" << line << ": warning: line ignored, expected \"key = value\"" << std::endl;
+
+	return std::move(result.entries);
+}
+
+/// <summary>
+///		Loads constants and translations into the builder, exactly like a runtime application would.
+/// </summary>
+/// <returns>True on success.</returns>
+bool loadCatalog(Options const& options_, Builder& builder_)
+{
+	builder_.setFallbackLanguage(options_.fallback);
+
+	if (!options_.constantsFile.empty())
+	{
+		auto entries = readEntries(options_.constantsFile);
+		if (!entries.has_value())
+			return false;
+
+		for (auto& entry : *entries)
+			builder_.setConstant(std::move(entry.key), std::move(entry.value));
+	}
+
+	for (std::uint16_t lang = 0; lang < options_.languageFiles.size(); ++lang)
+	{
+		auto const& path = options_.languageFiles[lang];
+		if (path == "-")
+			continue;
+
+		auto entries = readEntries(path);
+		if (!entries.has_value())
+			return false;
+
+		std::vector< rexrn::loc::CatalogEntry<char> const* > ignored;
+		std::vector<std::size_t> tooLarge;
+		for (auto const& [templateIndex, translation] : rexrn::loc::collectTranslations(*entries, &ignored, &tooLarge))
+			builder_.setTemplateTranslation(templateIndex, lang, std::string(translation));
+
+		for (auto const* entry : ignored)
+			std::cerr << path << ":" << entry->line << ": warning: \"" << entry->key << "\" is not a template index" << std::endl;
+		for (auto line : tooLarge)
+			std::cerr << path << ":" << line << ": warning: template index above " << rexrn::loc::DefaultMaxTemplateIndex << " ignored" << std::endl;
+	}
+
+	if (!builder_.freeze())
+		std::cerr << "warning: cyclic template references left unresolved" << std::endl;
+
+	return true;
+}
+
+/// <summary>
+///		Writes string view expression with escaped literal of the specified string.
+/// </summary>
+void writeStringView(std::ostream& output_, std::string_view str_)
+{
+	output_ << "std::string_view(\"";
+	for (char ch : str_)
+	{
+		auto const byte = static_cast<unsigned char>(ch);
+		switch(ch)
+		{
+		case '"': 	output_ << "\\\""; break;
+		case '\\': 	output_ << "\\\\"; break;
+		case '\n': 	output_ << "\\n"; break;
+		case '\t': 	output_ << "\\t"; break;
+		default:
+			if (byte < 0x20 || byte >= 0x7F)
+			{
+				// Octal escape has at most 3 digits, so it never swallows following characters.
+				char buffer[8];
+				std::snprintf(buffer, sizeof(buffer), "\\%03o", byte);
+				output_ << buffer;
+			}
+			else
+				output_ << ch;
+			break;
+		}
+	}
+	output_ << "\", " << str_.size() << ")";
+}
+
+/// <summary>
+///		Writes the generated header.
+/// </summary>
+void writeHeader(std::ostream& output_, Options const& options_, Builder const& builder_)
+{
+	auto const numLanguages = static_cast<std::uint16_t>(options_.languageFiles.size());
+	auto const numTemplates = builder_.getNumTemplates();
+
+	output_ <<
+		"// Generated by CatalogCodegen. Do not edit.\n"
+		"#pragma once\n"
+		"\n"
+		"#include <Rexrn/LocCpp/StaticStringBuilder.hpp>\n"
+		"\n"
+		"namespace " << options_.namespaceName << "\n"
+		"{\n"
+		"\n"
+		"inline constexpr std::uint16_t NumLanguages = " << numLanguages << ";\n"
+		"inline constexpr std::size_t NumTemplates = " << numTemplates << ";\n"
+		"\n";
+
+	// Format points of every translation, in the same order as translations:
+	std::size_t numFormatPoints = 0;
+	output_ << "inline constexpr rexrn::loc::TranslationView<char>::FormatPoint FormatPoints[] = {\n";
+	for (std::size_t i = 0; i < numTemplates; ++i)
+	{
+		for (std::uint16_t lang = 0; lang < numLanguages; ++lang)
+		{
+			auto const view = builder_.getTranslationView(i, lang);
+			for (std::size_t p = 0; p < view.numFormatPoints; ++p)
+			{
+				output_ << "\t{ " << view.formatPoints[p].first << ", ";
+				writeStringView(output_, view.formatPoints[p].second);
+				output_ << " },\n";
+			}
+			numFormatPoints += view.numFormatPoints;
+		}
+	}
+	// Array cannot be empty:
+	if (numFormatPoints == 0)
+		output_ << "\t{ 0, std::string_view() }\n";
+	output_ << "};\n\n";
+
+	// Translations, NumLanguages entries per template:
+	std::size_t firstFormatPoint = 0;
+	output_ << "inline constexpr rexrn::loc::TranslationView<char> Translations[] = {\n";
+	for (std::size_t i = 0; i < numTemplates; ++i)
+	{
+		output_ << "\t// Template " << i << ":\n";
+		for (std::uint16_t lang = 0; lang < numLanguages; ++lang)
+		{
+			auto const view = builder_.getTranslationView(i, lang);
+			if (!view.translated)
+			{
+				output_ << "\t{},\n";
+				continue;
+			}
+
+			output_ << "\t{ ";
+			writeStringView(output_, view.formatBase);
+			output_ << ", FormatPoints + " << firstFormatPoint << ", " << view.numFormatPoints << ", true },\n";
+
+			firstFormatPoint += view.numFormatPoints;
+		}
+	}
+	if (numTemplates == 0)
+		output_ << "\t{}\n";
+	output_ << "};\n\n";
+
+	output_ <<
+		"inline constexpr rexrn::loc::StaticStringBuilder<NumLanguages> Catalog{ Translations, NumTemplates, " << options_.fallback << " };\n"
+		"\n"
+		"} // namespace " << options_.namespaceName << "\n";
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+	Options options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage();
+		return 1;
+	}
+
+	Builder builder;
+	if (!loadCatalog(options, builder))
+		return 1;
+
+	// Generate into memory first, so that the output is not left half-written on failure.
+	std::ostringstream header;
+	writeHeader(header, options, builder);
+
+	std::ofstream output(options.outputFile, std::ios::out | std::ios::trunc | std::ios::binary);
+	output << header.str();
+	if (!output)
+	{
+		std::cerr << "Could not write " << options.outputFile << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
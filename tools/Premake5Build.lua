@@ -0,0 +1,3 @@
+group "Tools"
+
+include("CatalogCodegen/Premake5Build.lua")